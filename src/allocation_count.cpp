@@ -0,0 +1,27 @@
+#include <cstdlib>
+#include <new>
+
+#include "bench_funcs.hpp"
+
+namespace {
+  std::size_t allocations = 0;
+} // namespace
+
+std::size_t bench::heap_allocations() noexcept { return allocations; }
+
+#ifdef DS_COUNT_ALLOCATIONS
+// replaces the global allocation functions of the program, only to count the
+// calls. It lives in its own file so the compiler never sees both sides of a
+// new / delete pair inlined together. Only the benchmark build defines
+// DS_COUNT_ALLOCATIONS, the tests run with the normal allocator.
+void* operator new( std::size_t size ) {
+  ++allocations;
+  if ( void* p = std::malloc( size != 0 ? size : 1 ) )
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete( void* p ) noexcept { std::free( p ); }
+
+void operator delete( void* p, std::size_t ) noexcept { std::free( p ); }
+#endif
@@ -0,0 +1,738 @@
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <list>
+#include <set>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "algorithms.hpp"
+#include "container/binarytree.hpp"
+#include "container/block_pool.hpp"
+#include "container/btree.hpp"
+#include "container/list.hpp"
+#include "container/stack.hpp"
+#include "container/vector.hpp"
+#include "numbers/floatingpoint.hpp"
+#include "numbers/integer.hpp"
+#include "numbers/limbs.hpp"
+#include "numbers/modular.hpp"
+#include "numbers/wide_integer.hpp"
+
+#include "bench_funcs.hpp"
+
+namespace bench {
+
+  namespace {
+    // results nobody reads are stored here, so the work producing them stays
+    volatile long sink = 0;
+
+    // heap allocations per operation since 'start', "-" if they are not counted
+    std::string allocations_since( size_t start, double ops ) {
+      if constexpr ( !counts_allocations )
+        return "-";
+
+      std::ostringstream out;
+      out << static_cast< double >( heap_allocations() - start ) / ops;
+      return out.str();
+    }
+
+    // runs 'func' once and returns the elapsed time in nanoseconds
+    template < typename Func >
+    double time_ns( Func&& func ) {
+      const auto start = std::chrono::steady_clock::now();
+      func();
+      const auto stop = std::chrono::steady_clock::now();
+      return std::chrono::duration< double, std::nano >( stop - start ).count();
+    }
+
+    template < typename Container >
+    double vector_push( size_t count ) {
+      Container c;
+      const auto ns = time_ns( [&] {
+        for ( size_t i = 0; i < count; ++i )
+          c.push_back( static_cast< int >( i ) );
+      } );
+      return ns / static_cast< double >( c.size() );
+    }
+
+    template < typename Container >
+    double stack_push( size_t count ) {
+      Container c;
+      const auto ns = time_ns( [&] {
+        for ( size_t i = 0; i < count; ++i )
+          c.push( static_cast< int >( i ) );
+      } );
+      return ns / static_cast< double >( c.size() );
+    }
+
+    // builds and destroys 'rounds' containers of 'count' elements each
+    template < typename Container >
+    double churn( size_t rounds, size_t count ) {
+      size_t total  = 0;
+      const auto ns = time_ns( [&] {
+        for ( size_t r = 0; r < rounds; ++r ) {
+          Container c;
+          for ( size_t i = 0; i < count; ++i )
+            c.push_back( static_cast< int >( i ) );
+          total += c.size();
+        }
+      } );
+      return ns / static_cast< double >( total );
+    }
+
+    template < typename Container >
+    double front_push( size_t count ) {
+      Container c;
+      const auto ns = time_ns( [&] {
+        for ( size_t i = 0; i < count; ++i )
+          c.push_front( static_cast< int >( i ) );
+      } );
+      return ns / static_cast< double >( count );
+    }
+
+    // inserts at and erases from random positions of a container of 'count' elements
+    template < typename Container, typename Insert, typename Erase >
+    double middle_ops( size_t count, Insert insert, Erase erase ) {
+      Container c;
+      for ( size_t i = 0; i < count; ++i )
+        c.push_back( static_cast< int >( i ) );
+
+      constexpr size_t ops = 2000;
+      size_t seed          = 12345;
+      const auto ns        = time_ns( [&] {
+        for ( size_t i = 0; i < ops; ++i ) {
+          seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+          insert( c, ( seed >> 33 ) % c.size() );
+          erase( c, ( seed >> 17 ) % c.size() );
+        }
+      } );
+      return ns / static_cast< double >( 2 * ops );
+    }
+
+    // erases a random node and inserts a new one in front of another random
+    // node, 'ops' times. Positions are kept as iterators, so only the cost of
+    // the node management is measured.
+    template < typename List, typename Emplace, typename Erase >
+    double random_node_ops( size_t count, size_t ops, Emplace emplace, Erase erase ) {
+      List l;
+      std::vector< typename List::iterator > handles;
+      handles.reserve( count );
+
+      for ( size_t i = 0; i < count; ++i )
+        handles.push_back( emplace( l, l.end(), static_cast< int >( i ) ) );
+
+      size_t seed   = 6789;
+      const auto ns = time_ns( [&] {
+        for ( size_t i = 0; i < ops; ++i ) {
+          seed             = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+          const auto victim = ( seed >> 33 ) % count;
+          auto before       = ( seed >> 13 ) % count;
+
+          if ( before == victim )
+            before = ( before + 1 ) % count;
+
+          erase( l, handles[victim] );
+          handles[victim] = emplace( l, handles[before], static_cast< int >( i ) );
+        }
+      } );
+      return ns / static_cast< double >( 2 * ops );
+    }
+
+    // inserts and erases at random indices, then reads random indices
+    template < typename List >
+    double positional_ops( size_t count, size_t ops ) {
+      List l;
+      for ( size_t i = 0; i < count; ++i )
+        l.emplace_back( static_cast< int >( i ) );
+
+      size_t seed = 4321;
+      long sum    = 0;
+      const auto ns = time_ns( [&] {
+        for ( size_t i = 0; i < ops; ++i ) {
+          seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+          l.erase_at( ( seed >> 33 ) % count );
+          l.insert( static_cast< int >( i ), ( seed >> 13 ) % count );
+          sum += l[( seed >> 23 ) % count];
+        }
+      } );
+
+      sink = sum;
+      return ns / static_cast< double >( 3 * ops );
+    }
+
+    // inserts 'keys', then looks every one of them up. Returns the ns per
+    // insert and per find.
+    template < typename Tree >
+    std::pair< double, double > tree_insert_find( const std::vector< int >& keys ) {
+      Tree tree;
+      long found = 0;
+
+      const auto insert_ns = time_ns( [&] {
+        for ( auto key : keys )
+          tree.insert( key );
+      } );
+
+      const auto find_ns = time_ns( [&] {
+        for ( auto key : keys ) {
+          if constexpr ( requires { tree.contains( key ); } )
+            found += tree.contains( key );
+          else
+            found += tree.find( key );
+        }
+      } );
+
+      sink         = found;
+      const auto n = static_cast< double >( keys.size() );
+      return { insert_ns / n, find_ns / n };
+    }
+
+    // limbs with random bits, the generator of the other benchmarks
+    std::vector< ds::limbs::limb > random_limbs( size_t count, size_t seed ) {
+      std::vector< ds::limbs::limb > out( count );
+      for ( auto& l : out ) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        l    = seed;
+      }
+      return out;
+    }
+
+    // average time of one multiplication of 'a' and 'b' by 'func'
+    template < typename Mul >
+    double multiply_ns( const std::vector< ds::limbs::limb >& a,
+                        const std::vector< ds::limbs::limb >& b, Mul mul ) {
+      std::vector< ds::limbs::limb > r( a.size() + b.size() );
+      const size_t rounds = std::max< size_t >( 1, 20'000'000 / ( a.size() * b.size() ) );
+
+      const auto ns = time_ns( [&] {
+        for ( size_t i = 0; i < rounds; ++i )
+          mul( r.data(), a.data(), a.size(), b.data(), b.size() );
+      } );
+      sink = static_cast< long >( r[r.size() / 2] );
+      return ns / static_cast< double >( rounds );
+    }
+
+    // average time of one division of 'a' by 'b' by 'func'
+    template < typename Div >
+    double divide_ns( const std::vector< ds::limbs::limb >& a,
+                      const std::vector< ds::limbs::limb >& b, Div div ) {
+      std::vector< ds::limbs::limb > q( a.size() - b.size() + 1 ), r( b.size() );
+      const size_t rounds = std::max< size_t >( 1, 20'000'000 / ( q.size() * b.size() ) );
+
+      const auto ns = time_ns( [&] {
+        for ( size_t i = 0; i < rounds; ++i )
+          div( q.data(), r.data(), a.data(), a.size(), b.data(), b.size() );
+      } );
+      sink = static_cast< long >( q[q.size() / 2] ^ r[r.size() / 2] );
+      return ns / static_cast< double >( rounds );
+    }
+  } // namespace
+
+  void push_throughput() {
+    using geometric_dm = ds::data_manager< int, void, ds::growth::geometric<> >;
+    using fixed_dm     = ds::data_manager< int, void, ds::growth::fixed_step<> >;
+
+    std::cout << "push throughput [ns / element]\n";
+    std::cout << "elements\tvector(geo)\tvector(+10)\tstack(geo)\tstack(+10)\n";
+
+    for ( size_t count = 1000; count <= 100'000'000; count *= 10 ) {
+      std::cout << count << '\t' << vector_push< ds::vector< int, geometric_dm > >( count );
+
+      // the fixed step policy is quadratic, larger sizes take minutes
+      if ( count <= 1'000'000 )
+        std::cout << '\t' << vector_push< ds::vector< int, fixed_dm > >( count );
+      else
+        std::cout << "\t-";
+
+      std::cout << '\t' << stack_push< ds::stack< int, geometric_dm > >( count );
+
+      if ( count <= 1'000'000 )
+        std::cout << '\t' << stack_push< ds::stack< int, fixed_dm > >( count );
+      else
+        std::cout << "\t-";
+
+      std::cout << '\n';
+    }
+  }
+
+
+  void block_churn() {
+    using pooled = ds::alloc_vector< int, ds::pool_allocator< int > >;
+
+    std::cout << "container churn [ns / element]\n";
+    std::cout << "elements\tstd::allocator\tpool_allocator\n";
+
+    for ( size_t count = 1000; count <= 1'000'000; count *= 10 ) {
+      const auto rounds = 10'000'000 / count;
+      std::cout << count << '\t' << churn< ds::vector< int > >( rounds, count ) << '\t'
+                << churn< pooled >( rounds, count ) << '\n';
+    }
+  }
+
+
+  void segment_scan() {
+    std::cout << "sum over ds::vector< int > [ns / element]\n";
+    std::cout << "elements\titerator\tsegments\n";
+
+    for ( size_t count = 1'000'000; count <= 100'000'000; count *= 10 ) {
+      ds::vector< int > vec;
+      for ( size_t i = 0; i < count; ++i )
+        vec.push_back( static_cast< int >( i & 0xff ) );
+
+      long long by_iterator = 0, by_segment = 0;
+
+      const auto iter_ns = time_ns( [&] {
+        for ( auto value : vec )
+          by_iterator += value;
+      } );
+
+      const auto segment_ns = time_ns( [&] { by_segment = ds::accumulate( vec, 0LL ); } );
+
+      const auto n = static_cast< double >( count );
+      std::cout << count << '\t' << iter_ns / n << '\t' << segment_ns / n
+                << ( by_iterator == by_segment ? "" : "\t(mismatch)" ) << '\n';
+    }
+  }
+
+
+  void front_and_middle() {
+    std::cout << "push_front [ns / element]\n";
+    std::cout << "elements\tds::vector\tstd::deque\n";
+
+    for ( size_t count = 1000; count <= 10'000'000; count *= 10 )
+      std::cout << count << '\t' << front_push< ds::vector< int > >( count ) << '\t'
+                << front_push< std::deque< int > >( count ) << '\n';
+
+    auto ds_insert  = []( ds::vector< int >& c, size_t i ) { c.insert( 1, i ); };
+    auto ds_erase   = []( ds::vector< int >& c, size_t i ) { c.erase_at( i ); };
+    auto deq_insert = []( std::deque< int >& c, size_t i ) {
+      c.insert( c.begin() + static_cast< ptrdiff_t >( i ), 1 );
+    };
+    auto deq_erase = []( std::deque< int >& c, size_t i ) {
+      c.erase( c.begin() + static_cast< ptrdiff_t >( i ) );
+    };
+    auto vec_insert = []( std::vector< int >& c, size_t i ) {
+      c.insert( c.begin() + static_cast< ptrdiff_t >( i ), 1 );
+    };
+    auto vec_erase = []( std::vector< int >& c, size_t i ) {
+      c.erase( c.begin() + static_cast< ptrdiff_t >( i ) );
+    };
+
+    std::cout << "random insert / erase [ns / operation]\n";
+    std::cout << "elements\tds::vector\tstd::deque\tstd::vector\n";
+
+    for ( size_t count = 1000; count <= 1'000'000; count *= 10 )
+      std::cout << count << '\t' << middle_ops< ds::vector< int > >( count, ds_insert, ds_erase )
+                << '\t' << middle_ops< std::deque< int > >( count, deq_insert, deq_erase ) << '\t'
+                << middle_ops< std::vector< int > >( count, vec_insert, vec_erase ) << '\n';
+  }
+
+
+  void list_random_ops() {
+    auto ds_emplace = []( ds::list< int >& l, ds::list< int >::iterator pos, int v ) {
+      return l.emplace( pos, v );
+    };
+    auto ds_erase = []( ds::list< int >& l, ds::list< int >::iterator pos ) { l.erase( pos ); };
+
+    auto std_emplace = []( std::list< int >& l, std::list< int >::iterator pos, int v ) {
+      return l.emplace( pos, v );
+    };
+    auto std_erase = []( std::list< int >& l, std::list< int >::iterator pos ) { l.erase( pos ); };
+
+    std::cout << "random list erase / insert [ns / operation]\n";
+    std::cout << "elements\tds::list\tstd::list\n";
+
+    for ( size_t count = 1000; count <= 1'000'000; count *= 10 )
+      std::cout << count << '\t'
+                << random_node_ops< ds::list< int > >( count, 1'000'000, ds_emplace, ds_erase )
+                << '\t'
+                << random_node_ops< std::list< int > >( count, 1'000'000, std_emplace, std_erase )
+                << '\n';
+  }
+
+
+  void list_positional_ops() {
+    std::cout << "list access / insert / erase by index [ns / operation]\n";
+    std::cout << "elements\tds::list\tds::indexed_list\n";
+
+    for ( size_t count = 1000; count <= 1'000'000; count *= 10 ) {
+      std::cout << count << '\t';
+
+      // the linear walk gets too slow for the larger sizes
+      if ( count <= 10'000 )
+        std::cout << positional_ops< ds::list< int > >( count, 10'000 );
+      else
+        std::cout << '-';
+
+      std::cout << '\t' << positional_ops< ds::indexed_list< int > >( count, 1'000'000 ) << '\n';
+    }
+  }
+
+
+  void tree_key_streams() {
+    constexpr size_t count = 1'000'000;
+
+    std::vector< int > sorted( count ), shuffled( count );
+    for ( size_t i = 0; i < count; ++i )
+      sorted[i] = static_cast< int >( i );
+
+    // Fisher-Yates with the same generator as the other benchmarks
+    shuffled    = sorted;
+    size_t seed = 1357;
+    for ( size_t i = count - 1; i > 0; --i ) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      std::swap( shuffled[i], shuffled[( seed >> 33 ) % ( i + 1 )] );
+    }
+
+    std::cout << "tree with 10^6 keys [ns / operation]\n";
+    std::cout << "keys\tbinarytree insert\tbinarytree find\tstd::multiset insert\t"
+                 "std::multiset find\n";
+
+    const auto streams = { std::pair{ "sorted", &sorted }, std::pair{ "random", &shuffled } };
+
+    for ( auto [name, keys] : streams ) {
+      const auto [ds_insert, ds_find]   = tree_insert_find< ds::binarytree< int > >( *keys );
+      const auto [std_insert, std_find] = tree_insert_find< std::multiset< int > >( *keys );
+
+      std::cout << name << '\t' << ds_insert << '\t' << ds_find << '\t' << std_insert << '\t'
+                << std_find << '\n';
+    }
+  }
+
+
+  void ordered_containers() {
+    constexpr size_t count = 1'000'000;
+
+    std::vector< int > sorted( count ), shuffled( count );
+    for ( size_t i = 0; i < count; ++i )
+      sorted[i] = static_cast< int >( i );
+
+    shuffled    = sorted;
+    size_t seed = 2468;
+    for ( size_t i = count - 1; i > 0; --i ) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      std::swap( shuffled[i], shuffled[( seed >> 33 ) % ( i + 1 )] );
+    }
+
+    const auto n = static_cast< double >( count );
+
+    std::cout << "ordered containers, 10^6 random keys [ns / element]\n";
+    std::cout << "container\tinsert\tfind\tscan\tbulk load\n";
+
+    {
+      const auto [insert, find] = tree_insert_find< ds::btree_set< int > >( shuffled );
+
+      ds::btree_set< int > set;
+      const auto load_ns =
+        time_ns( [&] { set = ds::btree_set< int >::build_from_sorted( sorted ); } );
+
+      long sum           = 0;
+      const auto scan_ns = time_ns( [&] {
+        for ( auto key : set )
+          sum += key;
+      } );
+      sink = sum;
+
+      std::cout << "ds::btree_set\t" << insert << '\t' << find << '\t' << scan_ns / n << '\t'
+                << load_ns / n << '\n';
+    }
+
+    {
+      const auto [insert, find] = tree_insert_find< ds::binarytree< int > >( shuffled );
+
+      ds::binarytree< int > tree;
+      for ( auto key : shuffled )
+        tree.insert( key );
+
+      long sum           = 0;
+      const auto scan_ns = time_ns( [&] {
+        for ( auto key : tree )
+          sum += key;
+      } );
+      sink = sum;
+
+      const auto load_ns =
+        time_ns( [&] { tree = ds::binarytree< int >::build_from_sorted( sorted ); } );
+
+      std::cout << "ds::binarytree\t" << insert << '\t' << find << '\t' << scan_ns / n << '\t'
+                << load_ns / n << '\n';
+    }
+
+    {
+      const auto [insert, find] = tree_insert_find< std::set< int > >( shuffled );
+
+      std::set< int > set;
+      const auto load_ns =
+        time_ns( [&] { set = std::set< int >( sorted.begin(), sorted.end() ); } );
+
+      long sum           = 0;
+      const auto scan_ns = time_ns( [&] {
+        for ( auto key : set )
+          sum += key;
+      } );
+      sink = sum;
+
+      std::cout << "std::set\t" << insert << '\t' << find << '\t' << scan_ns / n << '\t'
+                << load_ns / n << '\n';
+    }
+  }
+
+
+  void integer_multiply() {
+    // decimal digits per 64 bit limb
+    constexpr double digits_per_limb = 19.265919722494796;
+
+    std::cout << "integer multiplication of two operands [us / multiplication]\n";
+    std::cout << "digits\tlimbs\tschoolbook\tdispatched ( thresholds "
+              << ds::limbs::karatsuba_threshold << ", " << ds::limbs::toom3_threshold << " )\n";
+
+    for ( size_t digits = 100; digits <= 1'000'000; digits *= 10 ) {
+      const auto count =
+        static_cast< size_t >( static_cast< double >( digits ) / digits_per_limb ) + 1;
+      const auto a = random_limbs( count, digits );
+      const auto b = random_limbs( count, digits + 1 );
+
+      const auto fast_ns = multiply_ns( a, b, ds::limbs::mul );
+
+      // schoolbook takes seconds for the largest operands
+      std::cout << digits << '\t' << count << '\t';
+      if ( digits <= 100'000 )
+        std::cout << multiply_ns( a, b, ds::limbs::mul_basecase ) / 1000;
+      else
+        std::cout << '-';
+      std::cout << '\t' << fast_ns / 1000 << '\n';
+    }
+  }
+
+
+  void integer_divide() {
+    constexpr double digits_per_limb = 19.265919722494796;
+
+    std::cout << "integer division of 2n by n digits [us / division]\n";
+    std::cout << "n digits\tlimbs\tlong division\tdispatched ( threshold "
+              << ds::limbs::div_newton_threshold << " )\tn x n multiplication\n";
+
+    for ( size_t digits = 100; digits <= 100'000; digits *= 10 ) {
+      const auto count =
+        static_cast< size_t >( static_cast< double >( digits ) / digits_per_limb ) + 1;
+      const auto a = random_limbs( 2 * count, digits );
+      const auto b = random_limbs( count, digits + 1 );
+
+      std::cout << digits << '\t' << count << '\t'
+                << divide_ns( a, b, ds::limbs::divrem_basecase ) / 1000 << '\t'
+                << divide_ns( a, b, ds::limbs::divrem ) / 1000 << '\t'
+                << multiply_ns( b, b, ds::limbs::mul ) / 1000 << '\n';
+    }
+  }
+
+
+  void integer_strings() {
+    std::cout << "decimal string conversion of ds::Int [ms]\n";
+    std::cout << "digits\tparse\tformat\n";
+
+    for ( size_t digits = 1000; digits <= 1'000'000; digits *= 10 ) {
+      std::string text( digits, '0' );
+      size_t seed = digits;
+      for ( auto& c : text ) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        c    = static_cast< char >( '0' + ( seed >> 33 ) % 10 );
+      }
+      text[0] = '7';
+
+      ds::Int n;
+      std::string back;
+      const auto parse_ns  = time_ns( [&] { n = ds::Int( text ); } );
+      const auto format_ns = time_ns( [&] { back = static_cast< std::string >( n ); } );
+      sink                 = static_cast< long >( back.size() );
+
+      std::cout << digits << '\t' << parse_ns / 1e6 << '\t' << format_ns / 1e6 << '\n';
+    }
+  }
+
+
+  void integer_small_values() {
+    constexpr size_t count = 1'000'000;
+
+    std::vector< long long > values( count );
+    size_t seed = 97531;
+    for ( auto& v : values ) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      v    = static_cast< long long >( seed >> 2 ) - ( 1LL << 60 );
+    }
+
+    const ds::Int a = 1'234'567'890'123LL, b = -987'654'321LL;
+
+    std::cout << "ds::Int with 64 bit values, 10^6 operations [heap allocations / op, ns / op]\n";
+    std::cout << "operation\tallocations\ttime\n";
+
+    const auto measure = [&]( const char* name, auto&& op ) {
+      long result        = 0;
+      const size_t start = heap_allocations();
+      const auto ns      = time_ns( [&] {
+        for ( size_t i = 0; i < count; ++i )
+          result += op( values[i] );
+      } );
+      sink = result;
+
+      const auto n = static_cast< double >( count );
+      std::cout << name << '\t' << allocations_since( start, n ) << '\t' << ns / n << '\n';
+    };
+
+    measure( "construct", []( long long v ) { return static_cast< long >( ds::Int( v ) ); } );
+    measure( "copy", [&]( long long ) {
+      const ds::Int copy = a;
+      return static_cast< long >( copy );
+    } );
+    measure( "add", [&]( long long v ) { return static_cast< long >( a + ds::Int( v ) ); } );
+    measure( "multiply", [&]( long long v ) { return static_cast< long >( b * ds::Int( v ) ); } );
+    measure( "divide", [&]( long long v ) { return static_cast< long >( ds::Int( v ) / b ); } );
+
+    // the sum lives on the heap, += reuses its limbs
+    ds::Int total = ds::Int( 1 ) << 256;
+    measure( "+= into 256 bit sum", [&]( long long v ) {
+      total += ds::Int( v );
+      return 0L;
+    } );
+    sink = static_cast< long >( total );
+  }
+
+
+  void integer_modular() {
+    std::cout << "modular exponentiation of n bit numbers [us / powmod]\n";
+    std::cout << "bits\tsquare and divide\tmontgomery\tfixed_montgomery\n";
+
+    const auto row = [&]< size_t Limbs >( std::integral_constant< size_t, Limbs > ) {
+      auto m_limbs = random_limbs( Limbs, Limbs );
+      m_limbs[0] |= 1;
+      m_limbs.back() |= 1ULL << 63;
+
+      const auto m        = ds::Int::from_limbs( m_limbs );
+      const auto base     = ds::Int::from_limbs( random_limbs( Limbs, Limbs + 1 ) ) % m;
+      const auto exponent = ds::Int::from_limbs( random_limbs( Limbs, Limbs + 2 ) );
+      const size_t rounds = 2048 / Limbs;
+
+      ds::Int result;
+      const auto divide_ns = time_ns( [&] {
+        for ( size_t i = 0; i < rounds; ++i ) {
+          result = 1;
+          ds::detail::for_each_bit_down( exponent.magnitude(), [&]( bool bit ) {
+            result = result * result % m;
+            if ( bit )
+              result = result * base % m;
+          } );
+        }
+      } );
+      sink = static_cast< long >( result );
+
+      const ds::montgomery<> dynamic( m );
+      const auto dynamic_ns = time_ns( [&] {
+        for ( size_t i = 0; i < rounds; ++i )
+          result = dynamic.pow( base, exponent );
+      } );
+      sink = static_cast< long >( result );
+
+      const ds::fixed_montgomery< Limbs > fixed( m );
+      const auto fixed_ns = time_ns( [&] {
+        for ( size_t i = 0; i < rounds; ++i )
+          result = fixed.pow( base, exponent );
+      } );
+      sink = static_cast< long >( result );
+
+      const auto n = static_cast< double >( rounds ) * 1000;
+      std::cout << Limbs * 64 << '\t' << divide_ns / n << '\t' << dynamic_ns / n << '\t'
+                << fixed_ns / n << '\n';
+    };
+
+    row( std::integral_constant< size_t, 4 >() );
+    row( std::integral_constant< size_t, 16 >() );
+    row( std::integral_constant< size_t, 32 >() );
+  }
+
+
+  void wide_integers() {
+    constexpr size_t count = 1'000'000;
+
+    std::cout << "256 bit arithmetic, ds::Int against ds::uint256, 10^6 operations "
+                 "[heap allocations / op, ns / op]\n";
+    std::cout << "operation\ttype\tallocations\ttime\n";
+
+    const auto measure = [&]( const char* name, const char* type, auto value, auto&& op ) {
+      const size_t start = heap_allocations();
+      const auto ns      = time_ns( [&] {
+        for ( size_t i = 0; i < count; ++i )
+          value = op( value, i );
+      } );
+      sink = static_cast< long >( value );
+
+      const auto n = static_cast< double >( count );
+      std::cout << name << '\t' << type << '\t' << allocations_since( start, n ) << '\t' << ns / n
+                << '\n';
+    };
+
+    const ds::Int big        = ds::Int::from_limbs( random_limbs( 4, 256 ) ) >> 1;
+    const auto half          = std::tuple( ds::Int( 1 ) << 254, ds::uint256( 1 ) << 254 );
+    const auto top           = std::tuple( ( ds::Int( 1 ) << 255 ) - 1, ~ds::uint256() >> 1 );
+    const ds::uint256 wide( big );
+
+    // every operation ends with adding 2^254, so the values stay between
+    // 2^254 and 2^256 and both types compute the same
+    const auto add = [&]< typename T >( const T& v, size_t i ) {
+      return ( v >> 1 ) + T( i ) + std::get< T >( half );
+    };
+    const auto mul = [&]< typename T >( const T& v, size_t ) {
+      return ( v >> 128 ) * ( v >> 128 ) + std::get< T >( half );
+    };
+    const auto div = [&]< typename T >( const T& v, size_t ) {
+      return std::get< T >( top ) / ( ( v >> 130 ) + 1 ) + std::get< T >( half );
+    };
+
+    measure( "add", "ds::Int", big, add );
+    measure( "add", "uint256", wide, add );
+    measure( "multiply", "ds::Int", big, mul );
+    measure( "multiply", "uint256", wide, mul );
+    measure( "divide", "ds::Int", big, div );
+    measure( "divide", "uint256", wide, div );
+  }
+
+
+  void floatingpoint_sum() {
+    constexpr size_t count = 100'000;
+
+    // 1e20, then 0.1 ... 0.1 and -1e20. The exact sum is count - 2 times the
+    // double closest to 0.1, a double sum loses all of them.
+    std::vector< double > terms( count, 0.1 );
+    terms.front() = 1e20;
+    terms.back()  = -1e20;
+
+    std::cout << "sum of 1e20, " << count - 2 << " x 0.1 and -1e20 [ns / addition]\n";
+    std::cout << "type\ttime\tsum\n";
+
+    double plain        = 0;
+    const auto plain_ns = time_ns( [&] {
+      for ( auto t : terms )
+        plain += t;
+    } );
+    const auto n = static_cast< double >( count );
+    std::cout << "double\t" << plain_ns / n << '\t' << plain << '\n';
+
+    const auto measure = [&]< size_t Digits >( std::integral_constant< size_t, Digits > ) {
+      using F = ds::floatingpoint< 10, Digits >;
+      const std::vector< F > values( terms.begin(), terms.end() );
+
+      F sum;
+      const auto ns = time_ns( [&] {
+        for ( const auto& v : values )
+          sum += v;
+      } );
+      std::cout << "floatingpoint< 10, " << Digits << " >\t" << ns / n << '\t' << sum << '\n';
+    };
+
+    measure( std::integral_constant< size_t, 16 >() );
+    measure( std::integral_constant< size_t, 40 >() );
+    measure( std::integral_constant< size_t, 100 >() );
+  }
+
+} // namespace bench
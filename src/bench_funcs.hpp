@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+
+namespace bench {
+
+  // heap allocations of the whole program so far, counted by the replaced
+  // global operator new in allocation_count.cpp. Builds without
+  // DS_COUNT_ALLOCATIONS ( make bench defines it ) keep the normal operator
+  // new and count nothing.
+  std::size_t heap_allocations() noexcept;
+
+#ifdef DS_COUNT_ALLOCATIONS
+  inline constexpr bool counts_allocations = true;
+#else
+  inline constexpr bool counts_allocations = false;
+#endif
+
+  void push_throughput();
+
+  void block_churn();
+
+  void segment_scan();
+
+  void front_and_middle();
+
+  void list_random_ops();
+
+  void list_positional_ops();
+
+  void tree_key_streams();
+
+  void ordered_containers();
+
+  void integer_multiply();
+
+  void integer_divide();
+
+  void integer_strings();
+
+  void integer_small_values();
+
+  void integer_modular();
+
+  void wide_integers();
+
+  void floatingpoint_sum();
+
+} // namespace bench
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <utility>
+
 #include "../Types.hpp"
 
 namespace ds {
@@ -13,6 +15,11 @@ namespace ds {
 
     duo_node( const T& t ) : value( t ) { }
 
+    // constructs the value in place from 'args', the node is not linked
+    template < typename... Args >
+    explicit duo_node( std::in_place_t, Args&&... args ) :
+        value( std::forward< Args >( args )... ) { }
+
     duo_node( const T& t, const_pointer< duo_node > _next,
               const_pointer< duo_node > _prev = nullptr ) :
         value( t ),
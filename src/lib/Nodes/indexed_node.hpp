@@ -0,0 +1,33 @@
+#pragma once
+
+#include <utility>
+
+#include "../Types.hpp"
+
+namespace ds {
+  // list node that is also part of an order statistic tree ( a treap ordered by
+  // list position ), so the n-th node can be found in O(log n)
+  template < typename T >
+  class indexed_node {
+  public:
+    T value{};
+    indexed_node *prev = nullptr, *next = nullptr;
+
+    // tree links, 'count' is the number of nodes in the subtree rooted here
+    indexed_node *parent = nullptr, *left = nullptr, *right = nullptr;
+    size_t count    = 1;
+    size_t priority = 0;
+
+    indexed_node() = default;
+
+    indexed_node( const T& t ) : value( t ) { }
+
+    // constructs the value in place from 'args', the node is not linked
+    template < typename... Args >
+    explicit indexed_node( std::in_place_t, Args&&... args ) :
+        value( std::forward< Args >( args )... ) { }
+
+    indexed_node( const indexed_node& ) = delete;
+    indexed_node& operator=( const indexed_node& ) = delete;
+  };
+} // namespace ds
@@ -3,7 +3,9 @@
 #include <type_traits>
 
 #include "duo_node.hpp"
+#include "indexed_node.hpp"
 #include "mono_node.hpp"
+#include "tree_node.hpp"
 
 namespace ds {
   template < typename T >
@@ -15,6 +17,12 @@ namespace ds {
   template < typename T >
   class is_node< duo_node< T > > : public std::true_type { };
 
+  template < typename T >
+  class is_node< tree_node< T > > : public std::true_type { };
+
+  template < typename T >
+  class is_node< indexed_node< T > > : public std::true_type { };
+
   template < typename T >
   constexpr bool is_node_v = is_node< T >::value;
 
@@ -121,9 +129,10 @@ namespace ds {
       ~traverse_iterator() override { }
     };
 
-    template < typename T >
-    class bi_traverse_iterator : public duo_iter_base< T > {
-      using iterator_base_type = duo_iter_base< T >;
+    // Node needs 'prev' and 'next' links
+    template < typename T, typename Node = duo_node< T > >
+    class bi_traverse_iterator : public iterator_base< T, Node > {
+      using iterator_base_type = iterator_base< T, Node >;
 
       using node_type = typename iterator_base_type::node_type;
 
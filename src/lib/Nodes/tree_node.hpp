@@ -0,0 +1,40 @@
+#pragma once
+
+#include <utility>
+
+namespace ds {
+  // node of a binary search tree, prev is the left and next the right subtree
+  template < typename T >
+  class tree_node {
+  public:
+    using node_pointer = tree_node*;
+
+    T value{};
+    node_pointer prev = nullptr, next = nullptr;
+
+    // nullptr for the root
+    node_pointer parent = nullptr;
+
+    // height of the subtree rooted here, a leaf has height 1
+    int height = 1;
+
+    tree_node() = default;
+
+    tree_node( const T& t ) : value( t ) { }
+
+    tree_node( T&& t ) : value( std::move( t ) ) { }
+
+    // constructs the value from 'args' in place
+    template < typename... Args >
+    explicit tree_node( std::in_place_t, Args&&... args ) :
+        value( std::forward< Args >( args )... ) { }
+
+    node_pointer& get_prev() noexcept { return prev; }
+
+    const node_pointer& get_prev() const noexcept { return prev; }
+
+    node_pointer& get_next() noexcept { return next; }
+
+    const node_pointer& get_next() const noexcept { return next; }
+  };
+} // namespace ds
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <memory>
+#include <type_traits>
+#include <utility>
+
 namespace ds {
   // a more readable alias of a function pointer
   template < typename Ret, typename... Args >
@@ -17,5 +21,18 @@ namespace ds {
   template < typename T >
   using const_read_pointer = const T* const;
 
+  // replaces the value of 'slot' by one constructed from 'args'. The new value
+  // is built in place when that cannot throw, otherwise it is move assigned.
+  template < typename T, typename... Args >
+  T& reconstruct( T& slot, Args&&... args ) {
+    if constexpr ( std::is_nothrow_constructible_v< T, Args&&... > ) {
+      std::destroy_at( std::addressof( slot ) );
+      return *std::construct_at( std::addressof( slot ), std::forward< Args >( args )... );
+    } else {
+      slot = T( std::forward< Args >( args )... );
+      return slot;
+    }
+  }
+
   namespace traits { }
 } // namespace ds
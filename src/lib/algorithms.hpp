@@ -1,7 +1,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <concepts>
+#include <functional>
+#include <memory>
+#include <numeric>
 
 #include "range.hpp"
 
@@ -25,4 +29,48 @@ namespace ds {
     auto iter      = r.begin();
     const auto end = r.end();
   }
+
+  // containers storing their elements in contiguous pieces ( ds::vector, ds::stack ).
+  // The algorithms below work per segment instead of per element, so the inner
+  // loops run over plain pointers and can be vectorized.
+  template < typename R >
+  concept segmented_range = requires( R r ) {
+    { *r.segments().begin() }
+    ->std::ranges::contiguous_range;
+  };
+
+  template < segmented_range R, typename OutputIt >
+  OutputIt copy( const R& r, OutputIt out ) {
+    for ( auto segment : r.segments() )
+      out = std::copy( segment.begin(), segment.end(), out );
+
+    return out;
+  }
+
+  template < segmented_range R, typename T >
+  void fill( R& r, const T& value ) {
+    for ( auto segment : r.segments() )
+      std::fill( segment.begin(), segment.end(), value );
+  }
+
+  // returns a pointer to the first element ( in storage order ) equal to value
+  // or nullptr if there is none
+  template < segmented_range R, typename T >
+  auto find( R& r, const T& value ) -> decltype( ( *r.segments().begin() ).data() ) {
+    for ( auto segment : r.segments() ) {
+      auto iter = std::find( segment.begin(), segment.end(), value );
+      if ( iter != segment.end() )
+        return std::to_address( iter );
+    }
+
+    return nullptr;
+  }
+
+  template < segmented_range R, typename T, typename BinaryOp = std::plus<> >
+  T accumulate( const R& r, T init, BinaryOp op = BinaryOp() ) {
+    for ( auto segment : r.segments() )
+      init = std::accumulate( segment.begin(), segment.end(), std::move( init ), op );
+
+    return init;
+  }
 } // namespace ds
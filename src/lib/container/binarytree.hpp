@@ -2,40 +2,169 @@
 
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <memory>
+#include <ranges>
 #include <type_traits>
+#include <vector>
 
 #include "../Nodes/node.hpp"
+#include "../range.hpp"
+#include "node_pool.hpp"
 
 namespace ds {
+  // AVL tree: every node caches the height of its subtree and the heights of
+  // two siblings differ by at most one, so insert, find and remove are
+  // O(log n) for any input order. Equal values are allowed.
+  // The nodes are owned by a node_pool and linked by plain pointers, including
+  // a parent pointer for in-order iteration.
   template < typename T >
   class binarytree {
     std::less< T > compare;
 
-    using node_type = duo_node< T >;
+    using node_type = tree_node< T >;
+    using link_type = node_type*;
 
+  public:
+    // in-order iterator, the values are const because they define the order
+    class iterator {
+      friend class binarytree;
+
+      const node_type* node  = nullptr;
+      const binarytree* tree = nullptr;
+
+      iterator( const node_type* n, const binarytree* t ) : node( n ), tree( t ) { }
+
+    public:
+      using iterator_category = std::bidirectional_iterator_tag;
+      using value_type        = T;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const T*;
+      using reference         = const T&;
+
+      iterator() = default;
+
+      reference operator*() const { return node->value; }
+
+      pointer operator->() const { return std::addressof( node->value ); }
+
+      iterator& operator++() {
+        node = successor( node );
+        return *this;
+      }
+
+      iterator operator++( int ) {
+        auto old = *this;
+        ++*this;
+        return old;
+      }
+
+      // decrementing end() gives the largest element
+      iterator& operator--() {
+        node = node != nullptr ? predecessor( node ) : rightmost( tree->root );
+        return *this;
+      }
+
+      iterator operator--( int ) {
+        auto old = *this;
+        --*this;
+        return old;
+      }
+
+      bool operator==( const iterator& other ) const { return node == other.node; }
+
+      bool operator!=( const iterator& other ) const { return !( *this == other ); }
+    };
+
+    using const_iterator = iterator;
+
+  private:
     unsigned int num_elem = 0;
-    std::shared_ptr< node_type > root;
+    link_type root        = nullptr;
+    node_pool< node_type > pool;
 
   public:
     binarytree() = default;
 
-    binarytree( const T& t ) {
-      root = std::make_shared< node_type >( t );
-      ++num_elem;
+    binarytree( const T& t ) { insert( t ); }
+
+    binarytree( const binarytree& other ) : num_elem( other.num_elem ) {
+      pool.reserve( other.num_elem );
+      root = clone( other.root, nullptr );
+    }
+
+    binarytree( binarytree&& other ) noexcept :
+        num_elem( std::exchange( other.num_elem, 0 ) ),
+        root( std::exchange( other.root, nullptr ) ), pool( std::move( other.pool ) ) { }
+
+    binarytree& operator=( const binarytree& other ) {
+      if ( this != std::addressof( other ) ) {
+        binarytree tmp( other );
+        swap( tmp );
+      }
+      return *this;
+    }
+
+    binarytree& operator=( binarytree&& other ) noexcept {
+      swap( other );
+      return *this;
+    }
+
+    ~binarytree() { destroy_nodes(); }
+
+    void swap( binarytree& other ) noexcept {
+      std::swap( num_elem, other.num_elem );
+      std::swap( root, other.root );
+      std::swap( pool, other.pool );
     }
 
-    void insert( const T& t ) {
-      if ( !root ) {
-        root = std::make_shared< node_type >( t );
-        ++num_elem;
+    // builds a perfectly balanced tree from a sorted range in O(n), all nodes
+    // come from a single allocation
+    template < std::ranges::input_range R >
+    static binarytree build_from_sorted( R&& sorted ) {
+      if constexpr ( !std::ranges::forward_range< R > ) {
+        // single pass ranges have to be counted before they are consumed
+        std::vector< T > values( std::ranges::begin( sorted ), std::ranges::end( sorted ) );
+        return build_from_sorted( values );
       } else {
-        compare( t, root->value ) ? insert_left( t, root ) : insert_right( t, root );
+        binarytree tree;
+        const auto count = static_cast< size_t >( std::ranges::distance( sorted ) );
+        auto iter        = std::ranges::begin( sorted );
+
+        tree.pool.reserve( count );
+        tree.root     = tree.build_subtree( iter, count, nullptr );
+        tree.num_elem = static_cast< unsigned int >( count );
+        return tree;
+      }
+    }
+
+    void insert( const T& t ) { emplace( t ); }
+
+    void insert( T&& t ) { emplace( std::move( t ) ); }
+
+    // constructs the value inside its node, no temporary T is created
+    template < typename... Args >
+    iterator emplace( Args&&... args ) {
+      link_type node   = pool.create( std::in_place, std::forward< Args >( args )... );
+      link_type parent = nullptr;
+      auto link        = std::addressof( root );
+
+      while ( *link ) { // *link != nullptr
+        parent = *link;
+        link   = compare( node->value, parent->value ) ? std::addressof( parent->prev )
+                                                       : std::addressof( parent->next );
       }
+
+      node->parent = parent;
+      *link        = node;
+      ++num_elem;
+
+      rebalance_from( parent );
+      return { node, this };
     }
 
     bool find( const T& t ) const {
-      auto ptr = root;
+      const node_type* ptr = root;
 
       while ( ptr ) { // ptr != nullptr
         if ( t == ptr->value )
@@ -46,102 +175,297 @@ namespace ds {
       return false;
     }
 
-    void remove( const T& t ) {
-      // TODO
+    // removes one element equal to 't', returns false if there is none
+    bool remove( const T& t ) {
+      link_type node = root;
+
+      while ( node && !equivalent( t, node->value ) )
+        node = compare( t, node->value ) ? node->prev : node->next;
+
+      if ( !node )
+        return false;
+
+      erase_node( node );
+      return true;
+    }
+
+    // removes the element at 'pos' and returns the iterator behind it, other
+    // iterators stay valid
+    iterator erase( iterator pos ) {
+      const auto next = std::next( pos );
+      erase_node( const_cast< link_type >( pos.node ) );
+      return next;
     }
 
-    void clear() {
-      root.reset();
-      num_elem = 0;
+    // first element not less than 't'
+    iterator lower_bound( const T& t ) const {
+      return bound( [&]( const T& value ) { return !compare( value, t ); } );
+    }
+
+    // first element greater than 't'
+    iterator upper_bound( const T& t ) const {
+      return bound( [&]( const T& value ) { return compare( t, value ); } );
+    }
+
+    // the elements in [lo, hi) in order, nothing is copied or allocated
+    iterator_range< iterator > range( const T& lo, const T& hi ) const {
+      return { lower_bound( lo ), lower_bound( hi ) };
+    }
+
+    iterator begin() const { return { leftmost( root ), this }; }
+
+    iterator end() const { return { nullptr, this }; }
+
+    // destroys every node and frees the whole pool at once
+    void clear() noexcept {
+      destroy_nodes();
+      pool.release();
     }
 
     bool is_empty() { return !root; }
 
-    void balance() {
-      const auto b = balance_of( root );
+    size_t size() const noexcept { return num_elem; }
 
-      if ( b > 1 ) {
-        rotate_left( root->get_prev(), root->get_prev()->get_next() );
-        rotate_right( root, root->get_prev() );
-      } else if ( b < -1 ) {
-        rotate_right( root->get_next(), root->get_next()->get_prev() );
-        rotate_left( root, root->get_next() );
+    // height of the tree, 0 if it is empty
+    int height() const noexcept { return height_of( root ); }
+
+    // the tree rebalances itself on every insert and remove
+    [[deprecated( "binarytree stays balanced, balance() does nothing" )]]
+    void balance() noexcept { }
+
+  private:
+    bool equivalent( const T& a, const T& b ) const {
+      return !compare( a, b ) && !compare( b, a );
+    }
+
+    // the leftmost node whose value satisfies 'pred', which has to be false
+    // for a prefix of the in-order sequence and true for the rest
+    template < typename Pred >
+    iterator bound( Pred pred ) const {
+      const node_type* result = nullptr;
+      const node_type* node   = root;
+
+      while ( node ) {
+        if ( pred( node->value ) ) {
+          result = node;
+          node   = node->prev;
+        } else {
+          node = node->next;
+        }
       }
+      return { result, this };
     }
 
-  private:
-    static int balance_of( const std::shared_ptr< node_type >& ptr ) {
-      return (int)height( ptr->prev ) - (int)height( ptr->next );
+    static const node_type* leftmost( const node_type* node ) noexcept {
+      if ( node != nullptr )
+        while ( node->prev != nullptr )
+          node = node->prev;
+      return node;
     }
 
-    static size_t height( const std::shared_ptr< node_type >& ptr ) {
-      return ptr ? std::max( height( ptr->get_next() ), height( ptr->get_prev() ) ) + 1 : 1;
+    static const node_type* rightmost( const node_type* node ) noexcept {
+      if ( node != nullptr )
+        while ( node->next != nullptr )
+          node = node->next;
+      return node;
     }
 
-    void insert_left( const T& t, std::shared_ptr< node_type >& node ) {
-      auto&& left = node->prev;
+    static const node_type* successor( const node_type* node ) noexcept {
+      if ( node->next != nullptr )
+        return leftmost( node->next );
 
-      if ( !left ) { // left == nullptr
-        left = std::make_shared< node_type >( t );
-        ++num_elem;
-      } else {
-        compare( t, left->value ) ? insert_left( t, left ) : insert_right( t, left );
-      }
+      while ( node->parent != nullptr && node == node->parent->next )
+        node = node->parent;
+      return node->parent;
+    }
+
+    static const node_type* predecessor( const node_type* node ) noexcept {
+      if ( node->prev != nullptr )
+        return rightmost( node->prev );
+
+      while ( node->parent != nullptr && node == node->parent->prev )
+        node = node->parent;
+      return node->parent;
+    }
+
+    // the link pointing to 'node'
+    link_type& link_of( link_type node ) noexcept {
+      if ( node->parent == nullptr )
+        return root;
+
+      return node->parent->prev == node ? node->parent->prev : node->parent->next;
     }
 
-    void insert_right( const T& t, std::shared_ptr< node_type >& node ) {
-      auto&& right = node->next;
+    void erase_node( link_type node ) {
+      link_type& link = link_of( node );
+      link_type start; // the lowest node whose subtree changed
+
+      if ( !node->prev || !node->next ) {
+        link_type child = node->prev ? node->prev : node->next;
+        if ( child )
+          child->parent = node->parent;
 
-      if ( !right ) { // right == nullptr
-        right = std::make_shared< node_type >( t );
-        ++num_elem;
+        link  = child;
+        start = node->parent;
       } else {
-        compare( t, right->value ) ? insert_left( t, right ) : insert_right( t, right );
+        // replace the node by its successor, the leftmost node of its right subtree
+        auto succ = const_cast< link_type >( leftmost( node->next ) );
+        start     = succ;
+
+        if ( succ->parent != node ) {
+          start = succ->parent;
+
+          succ->parent->prev = succ->next;
+          if ( succ->next )
+            succ->next->parent = succ->parent;
+
+          succ->next         = node->next;
+          succ->next->parent = succ;
+        }
+
+        succ->prev         = node->prev;
+        succ->prev->parent = succ;
+        succ->parent       = node->parent;
+        link               = succ;
       }
+
+      pool.destroy( node );
+      --num_elem;
+      rebalance_from( start );
+    }
+
+    static int height_of( const node_type* ptr ) noexcept { return ptr ? ptr->height : 0; }
+
+    static void update_height( node_type& node ) noexcept {
+      node.height = std::max( height_of( node.prev ), height_of( node.next ) ) + 1;
+    }
+
+    static int balance_of( const node_type& node ) noexcept {
+      return height_of( node.prev ) - height_of( node.next );
     }
 
-    static void rotate_left( std::shared_ptr< node_type >& top, std::shared_ptr< node_type >& k ) {
-      //       top         //
-      //        |          //
-      //        k          //
-      //      /   \        //
-      //         k_right   //
-      //          /    \   //
-      //       r_left      //
+    // rebalances 'node' and all its ancestors
+    void rebalance_from( link_type node ) {
+      while ( node ) {
+        link_type parent = node->parent;
+        rebalance( link_of( node ) );
+        node = parent;
+      }
+    }
 
-      auto k_right = k->next;
-      auto r_left  = k_right->prev;
+    // restores the AVL property at 'link', whose subtrees are balanced already
+    static void rebalance( link_type& link ) {
+      update_height( *link );
+      const auto b = balance_of( *link );
 
-      k->next = r_left;
+      if ( b > 1 ) {
+        if ( balance_of( *link->prev ) < 0 )
+          rotate_left( link->prev );
+        rotate_right( link );
+      } else if ( b < -1 ) {
+        if ( balance_of( *link->next ) > 0 )
+          rotate_right( link->next );
+        rotate_left( link );
+      }
+    }
 
-      if ( top->next == k )
-        top->next = k_right;
-      else
-        top->prev = k_right;
+    static void rotate_left( link_type& link ) {
+      //     k                  r       //
+      //   /   \              /   \     //
+      //         r    ->     k          //
+      //       /   \       /   \        //
+      //    r_left            r_left    //
+
+      link_type k = link;
+      link_type r = k->next;
+
+      k->next = r->prev;
+      if ( k->next )
+        k->next->parent = k;
+      update_height( *k );
+
+      r->parent = k->parent;
+      r->prev   = k;
+      k->parent = r;
+      update_height( *r );
+      link = r;
+    }
 
-      k_right->prev = k;
+    static void rotate_right( link_type& link ) {
+      //       k              l         //
+      //     /   \          /   \       //
+      //    l         ->          k     //
+      //  /   \                 /   \   //
+      //     l_right         l_right    //
+
+      link_type k = link;
+      link_type l = k->prev;
+
+      k->prev = l->next;
+      if ( k->prev )
+        k->prev->parent = k;
+      update_height( *k );
+
+      l->parent = k->parent;
+      l->next   = k;
+      k->parent = l;
+      update_height( *l );
+      link = l;
     }
 
-    static void rotate_right( std::shared_ptr< node_type >& top, std::shared_ptr< node_type >& k ) {
-      //         top       //
-      //          |        //
-      //          k        //
-      //        /   \      //
-      //    k_left         //
-      //    /    \         //
-      //        l_right    //
+    // creates the next 'count' values of 'iter' as a subtree, in order, so the
+    // middle one becomes its root
+    template < typename Iter >
+    link_type build_subtree( Iter& iter, size_t count, link_type parent ) {
+      if ( count == 0 )
+        return nullptr;
+
+      const size_t left_count = ( count - 1 ) / 2;
+      link_type left          = build_subtree( iter, left_count, nullptr );
+
+      link_type node = pool.create( std::in_place, *iter );
+      ++iter;
 
-      auto k_left  = k->prev;
-      auto l_right = k_left->next;
+      node->parent = parent;
+      node->prev   = left;
+      node->next   = build_subtree( iter, count - 1 - left_count, node );
 
-      k->prev = l_right;
+      if ( left )
+        left->parent = node;
+      update_height( *node );
+      return node;
+    }
+
+    link_type clone( const node_type* node, link_type parent ) {
+      if ( node == nullptr )
+        return nullptr;
+
+      link_type copy = pool.create( node->value );
+      copy->height   = node->height;
+      copy->parent   = parent;
+      copy->prev     = clone( node->prev, copy );
+      copy->next     = clone( node->next, copy );
+      return copy;
+    }
 
-      if ( top->next == k )
-        top->next = k_left;
-      else
-        top->prev = k_left;
+    // flattens the tree by right rotations while destroying it, so no stack is
+    // needed. The parent links are not maintained, the nodes are gone afterwards.
+    void destroy_nodes() noexcept {
+      if constexpr ( !std::is_trivially_destructible_v< T > ) {
+        while ( root != nullptr ) {
+          if ( root->prev != nullptr ) {
+            link_type left = root->prev;
+            root->prev     = left->next;
+            left->next     = root;
+            root           = left;
+          } else {
+            pool.destroy( std::exchange( root, root->next ) );
+          }
+        }
+      }
 
-      k_left->next = k;
+      root     = nullptr;
+      num_elem = 0;
     }
   };
 } // namespace ds
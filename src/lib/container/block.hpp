@@ -2,13 +2,27 @@
 
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <iterator>
 #include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
 
 #include "../Types.hpp"
 
 namespace ds {
-  template < typename T, size_t Block_size = 0x800 >
+  // tag to request a block without constructing any of its elements
+  struct uninitialized_t {
+    explicit uninitialized_t() = default;
+  };
+
+  inline constexpr uninitialized_t uninitialized{};
+
+  // a block owns raw storage for num_elements values. Slots are constructed
+  // on demand via emplace, the constructed slots always form one contiguous
+  // range [first, last) which is destroyed together with the block.
+  template < typename T, size_t Block_size = 0x800, typename Alloc = std::allocator< T > >
   class block {
   public:
     static constexpr size_t num_elements = Block_size / sizeof( T );
@@ -21,6 +35,8 @@ namespace ds {
 
     using const_pointer = T* const;
 
+    using allocator_type = typename std::allocator_traits< Alloc >::template rebind_alloc< T >;
+
     class block_iterator;
     class reverse_block_iterator;
 
@@ -28,37 +44,158 @@ namespace ds {
     using reverse_iterator = reverse_block_iterator;
 
   private:
-    std::unique_ptr< value_type[] > elems;
+    using alloc_traits = std::allocator_traits< allocator_type >;
+
+    [[no_unique_address]] allocator_type alloc{};
+    pointer elems = nullptr;
+    size_t first = 0, last = 0;
+
+    pointer allocate() { return alloc_traits::allocate( alloc, num_elements ); }
+
+    void deallocate( pointer ptr ) noexcept {
+      if ( ptr != nullptr )
+        alloc_traits::deallocate( alloc, ptr, num_elements );
+    }
 
   public:
     block() = default;
 
-    block( const value_type& val ) : elems( std::make_unique< value_type[] >( num_elements ) ) {
-      std::fill( elems.get(), elems.get() + num_elements, val );
+    explicit block( uninitialized_t, const allocator_type& a = allocator_type() ) :
+        alloc( a ), elems( allocate() ) { }
+
+    block( const value_type& val, const allocator_type& a = allocator_type() ) :
+        alloc( a ), elems( allocate() ) {
+      std::uninitialized_fill_n( elems, num_elements, val );
+      last = num_elements;
     }
 
-    block( const block& other ) : elems( std::make_unique< value_type[] >( num_elements ) ) {
-      std::copy( other.elems.get(), other.elems.get() + num_elements, elems.get() );
+    block( const block& other ) :
+        alloc( alloc_traits::select_on_container_copy_construction( other.alloc ) ),
+        elems( other.elems != nullptr ? allocate() : nullptr ), first( other.first ),
+        last( other.last ) {
+      std::uninitialized_copy( other.elems + first, other.elems + last, elems + first );
     }
 
-    block( block&& other ) : elems( std::move( other.elems ) ) { }
+    block( block&& other ) noexcept :
+        alloc( other.alloc ), elems( std::exchange( other.elems, nullptr ) ),
+        first( std::exchange( other.first, 0 ) ), last( std::exchange( other.last, 0 ) ) { }
 
     block& operator=( const block& other ) {
-      std::copy( other.elems.get(), other.elems.get() + num_elements, elems.get() );
+      if ( this != &other )
+        *this = block( other );
       return *this;
     }
 
     block& operator=( block&& other ) noexcept {
-      elems = std::move( other.elems );
+      std::swap( alloc, other.alloc );
+      std::swap( elems, other.elems );
+      std::swap( first, other.first );
+      std::swap( last, other.last );
       return *this;
     }
 
-  private:
-    const_pointer get_begin() const noexcept { return elems.get(); }
+    ~block() {
+      clear();
+      deallocate( elems );
+    }
 
-    const_pointer get_rbegin() const noexcept { return elems.get() + ( num_elements - 1 ); }
+  private:
+    const_pointer get_begin() const noexcept { return elems; }
+
+    const_pointer get_rbegin() const noexcept { return elems + ( num_elements - 1 ); }
+
+    // the slots [index, index + count) were constructed, they border the old range
+    void add_constructed( size_t index, size_t count ) noexcept {
+      if ( first == last ) {
+        first = index;
+        last  = index + count;
+      } else if ( index == last ) {
+        last += count;
+      } else {
+        assert( index + count == first );
+        first = index;
+      }
+    }
 
   public:
+    // constructs the slot at 'index', which has to border the constructed range
+    template < typename... Args >
+    reference emplace( size_t index, Args&&... args ) {
+      assert( elems != nullptr && index < num_elements );
+
+      pointer slot = std::construct_at( elems + index, std::forward< Args >( args )... );
+      add_constructed( index, 1 );
+      return *slot;
+    }
+
+    // constructs the slots [index, index + count) from the values at 'src' and
+    // returns the iterator past the last value read
+    template < typename InputIt >
+    InputIt construct_n( size_t index, InputIt src, size_t count ) {
+      assert( elems != nullptr && index + count <= num_elements );
+
+      using category = typename std::iterator_traits< InputIt >::iterator_category;
+
+      if constexpr ( std::is_base_of_v< std::random_access_iterator_tag, category > ) {
+        std::uninitialized_copy_n( src, count, elems + index );
+        src += static_cast< typename std::iterator_traits< InputIt >::difference_type >( count );
+      } else {
+        size_t done = 0;
+        try {
+          for ( ; done < count; ++done, ++src )
+            std::construct_at( elems + index + done, *src );
+        } catch ( ... ) {
+          std::destroy( elems + index, elems + index + done );
+          throw;
+        }
+      }
+
+      add_constructed( index, count );
+      return src;
+    }
+
+    // constructs the slots [index, index + count) as copies of 'val'
+    void fill_n( size_t index, size_t count, const value_type& val ) {
+      assert( elems != nullptr && index + count <= num_elements );
+
+      std::uninitialized_fill_n( elems + index, count, val );
+      add_constructed( index, count );
+    }
+
+    // destroys the slot at 'index', which has to be the first or last constructed one
+    void destroy( size_t index ) noexcept { destroy_n( index, 1 ); }
+
+    // destroys the slots [index, index + count), which have to be at the
+    // front or the back of the constructed range
+    void destroy_n( size_t index, size_t count ) noexcept {
+      assert( index >= first && index + count <= last );
+      assert( index == first || index + count == last );
+
+      if constexpr ( !std::is_trivially_destructible_v< value_type > )
+        std::destroy( elems + index, elems + index + count );
+
+      if ( index == first )
+        first += count;
+      else
+        last -= count;
+
+      if ( first == last )
+        first = last = 0;
+    }
+
+    void clear() noexcept {
+      if constexpr ( !std::is_trivially_destructible_v< value_type > )
+        std::destroy( elems + first, elems + last );
+
+      first = last = 0;
+    }
+
+    bool is_allocated() const noexcept { return elems != nullptr; }
+
+    allocator_type get_allocator() const noexcept { return alloc; }
+
+    bool is_constructed( size_t index ) const noexcept { return index >= first && index < last; }
+
     reference operator[]( size_t index ) { return elems[index]; }
 
     const_reference operator[]( size_t index ) const { return elems[index]; }
@@ -84,10 +221,10 @@ namespace ds {
     constexpr auto rend() const noexcept { return reverse_iterator( num_elements, this ); }
   };
 
-  template < typename T, size_t S >
-  class block< T, S >::block_iterator {
+  template < typename T, size_t S, typename A >
+  class block< T, S, A >::block_iterator {
   public:
-    using block_type = block< T, S >;
+    using block_type = block< T, S, A >;
     using size_type  = size_t;
 
     // iterator types
@@ -115,8 +252,8 @@ namespace ds {
     block_iterator& operator=( const block_iterator& ) = default;
     block_iterator& operator=( block_iterator&& ) = default;
 
-    explicit operator block< T, S >::reverse_block_iterator() {
-      return block< T, S >::reverse_block_iterator( size - offset, block_pos );
+    explicit operator block< T, S, A >::reverse_block_iterator() {
+      return block< T, S, A >::reverse_block_iterator( size - offset, block_pos );
     }
 
     reference operator*() {
@@ -212,10 +349,10 @@ namespace ds {
     }
   };
 
-  template < typename T, size_t S >
-  class block< T, S >::reverse_block_iterator {
+  template < typename T, size_t S, typename A >
+  class block< T, S, A >::reverse_block_iterator {
   public:
-    using block_type = block< T, S >;
+    using block_type = block< T, S, A >;
     using size_type  = size_t;
 
     // iterator types
@@ -243,8 +380,8 @@ namespace ds {
     reverse_block_iterator& operator=( const reverse_block_iterator& ) = default;
     reverse_block_iterator& operator=( reverse_block_iterator&& ) = default;
 
-    explicit operator block< T, S >::block_iterator() {
-      return block< T, S >::block_iterator( size - offset, block_pos );
+    explicit operator block< T, S, A >::block_iterator() {
+      return block< T, S, A >::block_iterator( size - offset, block_pos );
     }
 
     reference operator*() {
@@ -342,6 +479,70 @@ namespace ds {
     }
   };
 
+  // range over the contiguous pieces of the slots [first, last) of a table of
+  // blocks. Every element is a std::span covering ( a part of ) one block, so
+  // loops over a segment compile to plain pointer loops.
+  template < typename Block, typename Value = typename Block::value_type >
+  class segment_range {
+  public:
+    using block_type   = Block;
+    using segment_type = std::span< Value >;
+
+    static constexpr size_t size = Block::num_elements;
+
+    class iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = segment_type;
+      using reference         = segment_type;
+      using difference_type   = ptrdiff_t;
+
+    private:
+      Block* blocks = nullptr;
+      size_t pos = 0, last = 0;
+
+      size_t segment_end() const noexcept { return std::min( last, ( pos / size + 1 ) * size ); }
+
+    public:
+      iterator() = default;
+
+      constexpr iterator( Block* b, size_t p, size_t l ) : blocks( b ), pos( p ), last( l ) { }
+
+      segment_type operator*() const {
+        auto& b = blocks[pos / size];
+        return segment_type( std::addressof( b[pos % size] ), segment_end() - pos );
+      }
+
+      iterator& operator++() noexcept {
+        pos = segment_end();
+        return *this;
+      }
+
+      iterator operator++( int ) noexcept {
+        auto prev = *this;
+        ++( *this );
+        return prev;
+      }
+
+      bool operator==( const iterator& other ) const noexcept { return pos == other.pos; }
+
+      bool operator!=( const iterator& other ) const noexcept { return !( *this == other ); }
+    };
+
+  private:
+    Block* blocks;
+    size_t first, last;
+
+  public:
+    constexpr segment_range( Block* b, size_t f, size_t l ) : blocks( b ), first( f ), last( l ) { }
+
+    iterator begin() const noexcept { return iterator( blocks, first, last ); }
+
+    iterator end() const noexcept { return iterator( blocks, last, last ); }
+
+    size_t element_count() const noexcept { return last - first; }
+  };
+
   template < typename T, size_t Size = block< T >::block_size() >
   constexpr block< T, Size >&& make_block( const T& value = T{} ) {
     return block< T, Size >( value );
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "../Types.hpp"
+
+namespace ds {
+  // a mutex that does nothing, for pools only used by a single thread
+  struct null_mutex {
+    void lock() noexcept { }
+    void unlock() noexcept { }
+  };
+
+  // hands out pieces of Piece_size bytes carved from chunks of Pieces_per_chunk
+  // pieces. Released pieces go to an intrusive free list and are reused before
+  // a new chunk is requested, so steady push/pop churn never reaches malloc.
+  // The chunks are returned to the system by release() or the destructor.
+  template < size_t Piece_size, typename Mutex = null_mutex, size_t Pieces_per_chunk = 32 >
+  class block_pool {
+  public:
+    static constexpr size_t alignment  = alignof( std::max_align_t );
+    static constexpr size_t piece_size = ( Piece_size + alignment - 1 ) / alignment * alignment;
+    static constexpr size_t chunk_size = piece_size * Pieces_per_chunk;
+
+    static_assert( Pieces_per_chunk != 0, "a chunk needs at least one piece" );
+
+  private:
+    struct free_piece {
+      free_piece* next;
+    };
+
+    free_piece* free_list = nullptr;
+    std::vector< void* > chunks;
+    Mutex mutex;
+
+    void add_chunk() {
+      auto chunk = static_cast< std::byte* >(
+        ::operator new( chunk_size, std::align_val_t( alignment ) ) );
+      chunks.push_back( chunk );
+
+      // link the pieces back to front, so they are handed out in address order
+      for ( size_t i = Pieces_per_chunk; i > 0; --i ) {
+        auto piece  = ::new ( chunk + ( i - 1 ) * piece_size ) free_piece;
+        piece->next = free_list;
+        free_list   = piece;
+      }
+    }
+
+  public:
+    block_pool() = default;
+
+    block_pool( const block_pool& ) = delete;
+    block_pool& operator=( const block_pool& ) = delete;
+
+    ~block_pool() { release(); }
+
+    void* allocate() {
+      std::lock_guard< Mutex > lock( mutex );
+
+      if ( free_list == nullptr )
+        add_chunk();
+
+      auto piece = free_list;
+      free_list  = piece->next;
+      return piece;
+    }
+
+    void deallocate( void* ptr ) noexcept {
+      std::lock_guard< Mutex > lock( mutex );
+
+      auto piece  = ::new ( ptr ) free_piece;
+      piece->next = free_list;
+      free_list   = piece;
+    }
+
+    // frees every chunk, all pieces handed out before are invalid afterwards
+    void release() noexcept {
+      std::lock_guard< Mutex > lock( mutex );
+
+      for ( auto chunk : chunks )
+        ::operator delete( chunk, std::align_val_t( alignment ) );
+
+      chunks.clear();
+      free_list = nullptr;
+    }
+
+    size_t chunk_count() const noexcept { return chunks.size(); }
+  };
+
+  // allocator serving requests of up to Block_size bytes from a block_pool and
+  // everything else from std::allocator. Default constructed allocators share
+  // one synchronized pool per Block_size; pass your own pool to avoid locking.
+  template < typename T, size_t Block_size = 0x800,
+             typename Pool = block_pool< Block_size, std::mutex > >
+  class pool_allocator {
+  public:
+    using value_type = T;
+    using pool_type  = Pool;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    template < typename U >
+    struct rebind {
+      using other = pool_allocator< U, Block_size, Pool >;
+    };
+
+  private:
+    pool_type* pool;
+
+    static constexpr bool fits( size_t n ) noexcept {
+      return alignof( T ) <= pool_type::alignment && n <= pool_type::piece_size / sizeof( T );
+    }
+
+  public:
+    static pool_type& shared_pool() {
+      // never destroyed: blocks may outlive every other static object
+      static pool_type* p = new pool_type();
+      return *p;
+    }
+
+    pool_allocator() : pool( std::addressof( shared_pool() ) ) { }
+
+    explicit pool_allocator( pool_type& p ) noexcept : pool( std::addressof( p ) ) { }
+
+    template < typename U >
+    pool_allocator( const pool_allocator< U, Block_size, Pool >& other ) noexcept :
+        pool( std::addressof( other.get_pool() ) ) { }
+
+    T* allocate( size_t n ) {
+      if ( fits( n ) )
+        return static_cast< T* >( pool->allocate() );
+
+      return std::allocator< T >().allocate( n );
+    }
+
+    void deallocate( T* ptr, size_t n ) noexcept {
+      if ( fits( n ) )
+        pool->deallocate( ptr );
+      else
+        std::allocator< T >().deallocate( ptr, n );
+    }
+
+    pool_type& get_pool() const noexcept { return *pool; }
+
+    template < typename U >
+    bool operator==( const pool_allocator< U, Block_size, Pool >& other ) const noexcept {
+      return pool == std::addressof( other.get_pool() );
+    }
+  };
+} // namespace ds
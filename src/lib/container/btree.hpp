@@ -0,0 +1,843 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../range.hpp"
+#include "node_pool.hpp"
+
+namespace ds {
+  namespace detail {
+    // the values stored next to the keys of a btree leaf, nothing for sets
+    template < typename T, size_t N >
+    struct leaf_values {
+      std::array< T, N > values;
+    };
+
+    template < size_t N >
+    struct leaf_values< void, N > { };
+
+    // a map element as seen through an iterator, references to key and value
+    template < typename Key, typename Value >
+    struct btree_reference : std::pair< const Key&, Value& > {
+      using std::pair< const Key&, Value& >::pair;
+    };
+
+    // the element types of btree iterators
+    template < typename Key, typename T, bool Const >
+    struct btree_entry {
+      using value_type = std::pair< Key, T >;
+      using reference  = btree_reference< Key, std::conditional_t< Const, const T, T > >;
+    };
+
+    template < typename Key, bool Const >
+    struct btree_entry< Key, void, Const > {
+      using value_type = Key;
+      using reference  = const Key&;
+    };
+  } // namespace detail
+
+  // B+ tree with unique keys. Like a block, every node holds an array sized by
+  // Node_size ( in bytes ), so a lookup reads a few cache lines per level
+  // instead of one node per comparison. All elements are stored in the leaves,
+  // which are linked for iteration. T = void makes it a set.
+  // Key and T have to be default constructible and movable. Inserting and
+  // erasing invalidate iterators.
+  template < typename Key, typename T, typename Compare = std::less< Key >,
+             size_t Node_size = 0x100 >
+  class btree {
+  public:
+    using key_type    = Key;
+    using mapped_type = T;
+    using key_compare = Compare;
+
+    static constexpr bool is_set = std::is_void_v< T >;
+
+    static constexpr size_t value_size = [] {
+      if constexpr ( is_set )
+        return size_t( 0 );
+      else
+        return sizeof( T );
+    }();
+
+    // elements per leaf and keys per inner node
+    static constexpr size_t leaf_capacity =
+      std::max< size_t >( 4, Node_size / ( sizeof( Key ) + value_size ) );
+    static constexpr size_t inner_capacity =
+      std::max< size_t >( 4, Node_size / ( sizeof( Key ) + sizeof( void* ) ) );
+
+  private:
+    // every node but the root is at least half full
+    static constexpr size_t min_leaf  = leaf_capacity / 2;
+    static constexpr size_t min_inner = inner_capacity / 2;
+
+    // a B+ tree of minimal fanout 3 and 2^64 elements is less than 41 levels high
+    static constexpr size_t max_height = 48;
+
+    struct node_base {
+      size_t count = 0;
+    };
+
+    struct leaf_node : node_base {
+      leaf_node *prev = nullptr, *next = nullptr;
+      std::array< Key, leaf_capacity > keys;
+      [[no_unique_address]] detail::leaf_values< T, leaf_capacity > data;
+    };
+
+    // keys[i] separates children[i] ( smaller keys ) from children[i + 1]
+    struct inner_node : node_base {
+      std::array< Key, inner_capacity > keys;
+      std::array< node_base*, inner_capacity + 1 > children;
+    };
+
+    using path_type = std::array< std::pair< inner_node*, size_t >, max_height >;
+
+    template < bool Const >
+    class basic_iterator {
+      friend class btree;
+      friend class basic_iterator< !Const >;
+
+      using leaf_pointer = std::conditional_t< Const, const leaf_node*, leaf_node* >;
+
+      leaf_pointer leaf = nullptr;
+      size_t pos        = 0;
+
+      basic_iterator( leaf_pointer l, size_t p ) : leaf( l ), pos( p ) { }
+
+    public:
+      using iterator_category = std::bidirectional_iterator_tag;
+      using value_type        = typename detail::btree_entry< Key, T, Const >::value_type;
+      using difference_type   = std::ptrdiff_t;
+      using reference         = typename detail::btree_entry< Key, T, Const >::reference;
+
+      // the pair of a map is a temporary, operator-> keeps it alive in here
+      struct arrow_proxy {
+        reference ref;
+
+        const reference* operator->() const { return std::addressof( ref ); }
+      };
+
+      basic_iterator() = default;
+
+      operator basic_iterator< true >() const requires( !Const ) { return { leaf, pos }; }
+
+      const Key& key() const { return leaf->keys[pos]; }
+
+      decltype( auto ) value() const requires( !is_set ) { return ( leaf->data.values[pos] ); }
+
+      // the key for sets, a pair of references to key and value for maps
+      reference operator*() const {
+        if constexpr ( is_set )
+          return key();
+        else
+          return reference( key(), value() );
+      }
+
+      auto operator->() const {
+        if constexpr ( is_set )
+          return std::addressof( key() );
+        else
+          return arrow_proxy{ **this };
+      }
+
+      basic_iterator& operator++() {
+        if ( ++pos == leaf->count && leaf->next != nullptr ) {
+          leaf = leaf->next;
+          pos  = 0;
+        }
+        return *this;
+      }
+
+      basic_iterator operator++( int ) {
+        auto old = *this;
+        ++*this;
+        return old;
+      }
+
+      basic_iterator& operator--() {
+        if ( pos == 0 ) {
+          leaf = leaf->prev;
+          pos  = leaf->count;
+        }
+        --pos;
+        return *this;
+      }
+
+      basic_iterator operator--( int ) {
+        auto old = *this;
+        --*this;
+        return old;
+      }
+
+      bool operator==( const basic_iterator& other ) const {
+        return leaf == other.leaf && pos == other.pos;
+      }
+
+      bool operator!=( const basic_iterator& other ) const { return !( *this == other ); }
+    };
+
+  public:
+    using iterator       = basic_iterator< false >;
+    using const_iterator = basic_iterator< true >;
+
+  private:
+    node_base* Root  = nullptr;
+    leaf_node* First = nullptr;
+    leaf_node* Last  = nullptr;
+    size_t Count     = 0;
+    size_t Height    = 0; // levels of inner nodes
+
+    [[no_unique_address]] Compare compare{};
+    node_pool< leaf_node > leaves;
+    node_pool< inner_node > inners;
+
+  public:
+    btree() = default;
+
+    explicit btree( const Compare& comp ) : compare( comp ) { }
+
+    btree( const btree& other ) : compare( other.compare ) {
+      for ( auto leaf = other.First; leaf != nullptr; leaf = leaf->next )
+        for ( size_t i = 0; i < leaf->count; ++i ) {
+          if constexpr ( is_set )
+            append_sorted( leaf->keys[i] );
+          else
+            append_sorted( leaf->keys[i], leaf->data.values[i] );
+        }
+
+      build_index();
+    }
+
+    btree( btree&& other ) noexcept { swap( other ); }
+
+    btree& operator=( const btree& other ) {
+      if ( this != std::addressof( other ) ) {
+        btree tmp( other );
+        swap( tmp );
+      }
+      return *this;
+    }
+
+    btree& operator=( btree&& other ) noexcept {
+      swap( other );
+      return *this;
+    }
+
+    ~btree() { destroy_nodes(); }
+
+    void swap( btree& other ) noexcept {
+      std::swap( Root, other.Root );
+      std::swap( First, other.First );
+      std::swap( Last, other.Last );
+      std::swap( Count, other.Count );
+      std::swap( Height, other.Height );
+      std::swap( compare, other.compare );
+      std::swap( leaves, other.leaves );
+      std::swap( inners, other.inners );
+    }
+
+    // builds the tree bottom up in O(n) from a range sorted by key: keys for a
+    // set, pairs of key and value for a map. Later duplicates are dropped.
+    template < typename R >
+    static btree build_from_sorted( R&& sorted, const Compare& comp = Compare() ) {
+      btree tree( comp );
+
+      for ( auto&& elem : sorted ) {
+        const Key& key = [&]() -> const Key& {
+          if constexpr ( is_set )
+            return elem;
+          else
+            return elem.first;
+        }();
+
+        if ( tree.Last != nullptr ) {
+          const Key& largest = tree.Last->keys[tree.Last->count - 1];
+          assert( !tree.compare( key, largest ) && "build_from_sorted needs sorted input" );
+
+          if ( !tree.compare( largest, key ) )
+            continue;
+        }
+
+        if constexpr ( is_set )
+          tree.append_sorted( elem );
+        else
+          tree.append_sorted( elem.first, elem.second );
+      }
+
+      tree.build_index();
+      return tree;
+    }
+
+    std::pair< iterator, bool > insert( Key key ) requires( is_set ) {
+      return insert_entry( std::move( key ) );
+    }
+
+    // V only delays forming the parameter, so sets never see a 'void' parameter
+    template < typename V = T >
+    std::pair< iterator, bool > insert( Key key, std::type_identity_t< V > value ) requires(
+      !is_set ) {
+      return insert_entry( std::move( key ), std::move( value ) );
+    }
+
+    // inserts a default constructed value if 'key' is missing
+    auto& operator[]( const Key& key ) requires( !is_set ) {
+      auto iter = find( key );
+      if ( iter == end() )
+        iter = insert_entry( Key( key ), T() ).first;
+
+      return iter.value();
+    }
+
+    // removes the element with 'key', returns the number of removed elements
+    size_t erase( const Key& key ) {
+      if ( Root == nullptr )
+        return 0;
+
+      path_type path;
+      size_t depth    = 0;
+      leaf_node* leaf = descend( key, path, depth );
+      const auto pos  = key_index( leaf, key );
+
+      if ( pos == leaf->count || compare( key, leaf->keys[pos] ) )
+        return 0;
+
+      shift_entries( leaf, pos + 1, leaf->count, -1 );
+      --leaf->count;
+      --Count;
+
+      fix_underflow( leaf, path, depth );
+      return 1;
+    }
+
+    // destroys every element and frees all nodes at once
+    void clear() noexcept {
+      destroy_nodes();
+      leaves.release();
+      inners.release();
+    }
+
+    iterator find( const Key& key ) { return find_impl< iterator >( *this, key ); }
+
+    const_iterator find( const Key& key ) const {
+      return find_impl< const_iterator >( *this, key );
+    }
+
+    bool contains( const Key& key ) const { return find( key ) != end(); }
+
+    // first element not less than 'key'
+    iterator lower_bound( const Key& key ) { return bound< iterator, false >( *this, key ); }
+
+    const_iterator lower_bound( const Key& key ) const {
+      return bound< const_iterator, false >( *this, key );
+    }
+
+    // first element greater than 'key'
+    iterator upper_bound( const Key& key ) { return bound< iterator, true >( *this, key ); }
+
+    const_iterator upper_bound( const Key& key ) const {
+      return bound< const_iterator, true >( *this, key );
+    }
+
+    // the elements with keys in [lo, hi)
+    iterator_range< iterator > range( const Key& lo, const Key& hi ) {
+      return { lower_bound( lo ), lower_bound( hi ) };
+    }
+
+    iterator_range< const_iterator > range( const Key& lo, const Key& hi ) const {
+      return { lower_bound( lo ), lower_bound( hi ) };
+    }
+
+    size_t size() const noexcept { return Count; }
+
+    bool is_empty() const noexcept { return Count == 0; }
+
+    // levels of inner nodes above the leaves, 0 for a single leaf
+    size_t height() const noexcept { return Height; }
+
+    iterator begin() noexcept { return { First, 0 }; }
+
+    const_iterator begin() const noexcept { return { First, 0 }; }
+
+    iterator end() noexcept { return { Last, Last != nullptr ? Last->count : 0 }; }
+
+    const_iterator end() const noexcept { return { Last, Last != nullptr ? Last->count : 0 }; }
+
+  private:
+    static leaf_node* as_leaf( node_base* node ) noexcept {
+      return static_cast< leaf_node* >( node );
+    }
+
+    static inner_node* as_inner( node_base* node ) noexcept {
+      return static_cast< inner_node* >( node );
+    }
+
+    // the child of 'node' whose subtree may contain 'key'
+    size_t child_index( const inner_node* node, const Key& key ) const {
+      const auto first = node->keys.begin();
+      return std::upper_bound( first, first + node->count, key, compare ) - first;
+    }
+
+    size_t key_index( const leaf_node* leaf, const Key& key ) const {
+      const auto first = leaf->keys.begin();
+      return std::lower_bound( first, first + leaf->count, key, compare ) - first;
+    }
+
+    // walks down to the leaf that may contain 'key' and records the way in 'path'
+    leaf_node* descend( const Key& key, path_type& path, size_t& depth ) const {
+      node_base* node = Root;
+      for ( size_t level = Height; level > 0; --level ) {
+        const auto inner = as_inner( node );
+        const auto index = child_index( inner, key );
+
+        path[depth++] = { inner, index };
+        node          = inner->children[index];
+      }
+      return as_leaf( node );
+    }
+
+    leaf_node* find_leaf( const Key& key ) const {
+      node_base* node = Root;
+      for ( size_t level = Height; level > 0; --level )
+        node = as_inner( node )->children[child_index( as_inner( node ), key )];
+
+      return as_leaf( node );
+    }
+
+    template < typename Iter, bool Upper, typename Self >
+    static Iter bound( Self& self, const Key& key ) {
+      if ( self.Root == nullptr )
+        return self.end();
+
+      leaf_node* leaf = self.find_leaf( key );
+      const auto first = leaf->keys.begin();
+      const auto last  = first + leaf->count;
+      size_t pos       = ( Upper ? std::upper_bound( first, last, key, self.compare )
+                                 : std::lower_bound( first, last, key, self.compare ) ) -
+                   first;
+
+      // the bound is the first element of the next leaf
+      if ( pos == leaf->count && leaf->next != nullptr ) {
+        leaf = leaf->next;
+        pos  = 0;
+      }
+      return { leaf, pos };
+    }
+
+    template < typename Iter, typename Self >
+    static Iter find_impl( Self& self, const Key& key ) {
+      Iter iter = bound< Iter, false >( self, key );
+      if ( iter != self.end() && !self.compare( key, iter.key() ) )
+        return iter;
+
+      return self.end();
+    }
+
+    // moves the entries [first, last) of 'leaf' by 'offset' slots
+    static void shift_entries( leaf_node* leaf, size_t first, size_t last, std::ptrdiff_t offset ) {
+      auto shift = [&]( auto& arr ) {
+        const auto begin = arr.begin() + first, end = arr.begin() + last;
+        if ( offset > 0 )
+          std::move_backward( begin, end, end + offset );
+        else
+          std::move( begin, end, begin + offset );
+      };
+
+      shift( leaf->keys );
+      if constexpr ( !is_set )
+        shift( leaf->data.values );
+    }
+
+    // moves the entries [first, last) of 'from' to 'to', starting at 'dest'
+    static void move_entries( leaf_node* from, size_t first, size_t last, leaf_node* to,
+                              size_t dest ) {
+      std::move( from->keys.begin() + first, from->keys.begin() + last, to->keys.begin() + dest );
+      if constexpr ( !is_set )
+        std::move( from->data.values.begin() + first, from->data.values.begin() + last,
+                   to->data.values.begin() + dest );
+    }
+
+    template < typename... Value >
+    static void set_entry( leaf_node* leaf, size_t pos, Key&& key, Value&&... value ) {
+      leaf->keys[pos] = std::move( key );
+      if constexpr ( !is_set )
+        leaf->data.values[pos] = ( std::forward< Value >( value ), ... );
+    }
+
+    template < typename... Value >
+    std::pair< iterator, bool > insert_entry( Key&& key, Value&&... value ) {
+      if ( Root == nullptr )
+        Root = First = Last = leaves.create();
+
+      path_type path;
+      size_t depth    = 0;
+      leaf_node* leaf = descend( key, path, depth );
+      size_t pos      = key_index( leaf, key );
+
+      if ( pos < leaf->count && !compare( key, leaf->keys[pos] ) )
+        return { iterator( leaf, pos ), false };
+
+      leaf_node* right = nullptr;
+
+      if ( leaf->count == leaf_capacity ) {
+        // split the leaf in half and insert into the half owning 'pos'
+        constexpr size_t half = ( leaf_capacity + 1 ) / 2;
+
+        right = leaves.create();
+        move_entries( leaf, half, leaf_capacity, right, 0 );
+        right->count = leaf_capacity - half;
+        leaf->count  = half;
+
+        right->prev = leaf;
+        right->next = leaf->next;
+        ( leaf->next != nullptr ? leaf->next->prev : Last ) = right;
+        leaf->next                                          = right;
+
+        if ( pos > half ) {
+          pos -= half;
+          leaf = right;
+        }
+      }
+
+      shift_entries( leaf, pos, leaf->count, 1 );
+      set_entry( leaf, pos, std::move( key ), std::forward< Value >( value )... );
+      ++leaf->count;
+      ++Count;
+
+      if ( right != nullptr )
+        insert_child( path, depth, Key( right->keys[0] ), right );
+
+      return { iterator( leaf, pos ), true };
+    }
+
+    // links 'child' with separator 'key' into the parent at the end of 'path',
+    // splitting full inner nodes on the way up
+    void insert_child( path_type& path, size_t depth, Key&& key, node_base* child ) {
+      while ( depth > 0 ) {
+        auto [parent, index] = path[--depth];
+        const auto count     = parent->count;
+
+        if ( count < inner_capacity ) {
+          std::move_backward( parent->keys.begin() + index, parent->keys.begin() + count,
+                              parent->keys.begin() + count + 1 );
+          std::move_backward( parent->children.begin() + index + 1,
+                              parent->children.begin() + count + 1,
+                              parent->children.begin() + count + 2 );
+          parent->keys[index]         = std::move( key );
+          parent->children[index + 1] = child;
+          ++parent->count;
+          return;
+        }
+
+        // the full node plus the new key, split around the middle key
+        std::array< Key, inner_capacity + 1 > keys;
+        std::array< node_base*, inner_capacity + 2 > children;
+
+        std::move( parent->keys.begin(), parent->keys.begin() + index, keys.begin() );
+        keys[index] = std::move( key );
+        std::move( parent->keys.begin() + index, parent->keys.end(), keys.begin() + index + 1 );
+
+        std::copy( parent->children.begin(), parent->children.begin() + index + 1,
+                   children.begin() );
+        children[index + 1] = child;
+        std::copy( parent->children.begin() + index + 1, parent->children.end(),
+                   children.begin() + index + 2 );
+
+        constexpr size_t mid = ( inner_capacity + 1 ) / 2;
+        inner_node* sibling  = inners.create();
+
+        std::move( keys.begin(), keys.begin() + mid, parent->keys.begin() );
+        std::copy( children.begin(), children.begin() + mid + 1, parent->children.begin() );
+        parent->count = mid;
+
+        std::move( keys.begin() + mid + 1, keys.end(), sibling->keys.begin() );
+        std::copy( children.begin() + mid + 1, children.end(), sibling->children.begin() );
+        sibling->count = inner_capacity - mid;
+
+        key   = std::move( keys[mid] );
+        child = sibling;
+      }
+
+      // the root was split
+      inner_node* root  = inners.create();
+      root->count       = 1;
+      root->keys[0]     = std::move( key );
+      root->children[0] = Root;
+      root->children[1] = child;
+      Root              = root;
+      ++Height;
+    }
+
+    // removes key 'index' and the child right of it from 'node'
+    static void remove_child( inner_node* node, size_t index ) {
+      const auto count = node->count;
+      std::move( node->keys.begin() + index + 1, node->keys.begin() + count,
+                 node->keys.begin() + index );
+      std::copy( node->children.begin() + index + 2, node->children.begin() + count + 1,
+                 node->children.begin() + index + 1 );
+      --node->count;
+    }
+
+    // refills 'node' from a sibling or merges it with one, up to the root
+    void fix_underflow( node_base* node, path_type& path, size_t depth ) {
+      for ( bool is_leaf = true;; is_leaf = false ) {
+        if ( depth == 0 ) {
+          if ( node->count == 0 ) {
+            if ( is_leaf ) {
+              leaves.destroy( as_leaf( node ) );
+              Root = First = Last = nullptr;
+            } else {
+              Root = as_inner( node )->children[0];
+              inners.destroy( as_inner( node ) );
+              --Height;
+            }
+          }
+          return;
+        }
+
+        if ( node->count >= ( is_leaf ? min_leaf : min_inner ) )
+          return;
+
+        auto [parent, index] = path[--depth];
+
+        if ( is_leaf ? refill_leaf( parent, index ) : refill_inner( parent, index ) )
+          return;
+
+        node = parent;
+      }
+    }
+
+    // returns false if the leaf had to be merged, which removes a key from 'parent'
+    bool refill_leaf( inner_node* parent, size_t index ) {
+      leaf_node* node = as_leaf( parent->children[index] );
+
+      if ( index > 0 ) {
+        leaf_node* left = as_leaf( parent->children[index - 1] );
+
+        if ( left->count > min_leaf ) {
+          shift_entries( node, 0, node->count, 1 );
+          move_entries( left, left->count - 1, left->count, node, 0 );
+          --left->count;
+          ++node->count;
+          parent->keys[index - 1] = node->keys[0];
+          return true;
+        }
+      }
+
+      if ( index < parent->count ) {
+        leaf_node* right = as_leaf( parent->children[index + 1] );
+
+        if ( right->count > min_leaf ) {
+          move_entries( right, 0, 1, node, node->count );
+          shift_entries( right, 1, right->count, -1 );
+          --right->count;
+          ++node->count;
+          parent->keys[index] = right->keys[0];
+          return true;
+        }
+      }
+
+      const size_t sep = index > 0 ? index - 1 : index;
+      leaf_node* left  = as_leaf( parent->children[sep] );
+      leaf_node* right = as_leaf( parent->children[sep + 1] );
+
+      move_entries( right, 0, right->count, left, left->count );
+      left->count += right->count;
+
+      left->next                                            = right->next;
+      ( right->next != nullptr ? right->next->prev : Last ) = left;
+
+      leaves.destroy( right );
+      remove_child( parent, sep );
+      return false;
+    }
+
+    bool refill_inner( inner_node* parent, size_t index ) {
+      inner_node* node = as_inner( parent->children[index] );
+
+      if ( index > 0 ) {
+        inner_node* left = as_inner( parent->children[index - 1] );
+
+        if ( left->count > min_inner ) {
+          std::move_backward( node->keys.begin(), node->keys.begin() + node->count,
+                              node->keys.begin() + node->count + 1 );
+          std::copy_backward( node->children.begin(), node->children.begin() + node->count + 1,
+                              node->children.begin() + node->count + 2 );
+
+          node->keys[0]           = std::move( parent->keys[index - 1] );
+          node->children[0]       = left->children[left->count];
+          parent->keys[index - 1] = std::move( left->keys[left->count - 1] );
+          --left->count;
+          ++node->count;
+          return true;
+        }
+      }
+
+      if ( index < parent->count ) {
+        inner_node* right = as_inner( parent->children[index + 1] );
+
+        if ( right->count > min_inner ) {
+          node->keys[node->count]         = std::move( parent->keys[index] );
+          node->children[node->count + 1] = right->children[0];
+          parent->keys[index]             = std::move( right->keys[0] );
+
+          std::move( right->keys.begin() + 1, right->keys.begin() + right->count,
+                     right->keys.begin() );
+          std::copy( right->children.begin() + 1, right->children.begin() + right->count + 1,
+                     right->children.begin() );
+          --right->count;
+          ++node->count;
+          return true;
+        }
+      }
+
+      const size_t sep  = index > 0 ? index - 1 : index;
+      inner_node* left  = as_inner( parent->children[sep] );
+      inner_node* right = as_inner( parent->children[sep + 1] );
+
+      left->keys[left->count] = std::move( parent->keys[sep] );
+      std::move( right->keys.begin(), right->keys.begin() + right->count,
+                 left->keys.begin() + left->count + 1 );
+      std::copy( right->children.begin(), right->children.begin() + right->count + 1,
+                 left->children.begin() + left->count + 1 );
+      left->count += right->count + 1;
+
+      inners.destroy( right );
+      remove_child( parent, sep );
+      return false;
+    }
+
+    // appends behind the largest key, only used while bulk loading
+    template < typename K, typename... Value >
+    void append_sorted( K&& key, Value&&... value ) {
+      if ( Last == nullptr || Last->count == leaf_capacity ) {
+        leaf_node* leaf                          = leaves.create();
+        leaf->prev                               = Last;
+        ( Last != nullptr ? Last->next : First ) = leaf;
+        Last                                     = leaf;
+      }
+
+      set_entry( Last, Last->count, Key( std::forward< K >( key ) ),
+                 std::forward< Value >( value )... );
+      ++Last->count;
+      ++Count;
+    }
+
+    // builds the inner nodes above the leaves appended by append_sorted
+    void build_index() {
+      // the leaves are full, only the last one may be too small
+      if ( Last != nullptr && Last->prev != nullptr && Last->count < min_leaf ) {
+        leaf_node* prev   = Last->prev;
+        const size_t move = ( prev->count + Last->count ) / 2 - Last->count;
+
+        shift_entries( Last, 0, Last->count, static_cast< std::ptrdiff_t >( move ) );
+        move_entries( prev, prev->count - move, prev->count, Last, 0 );
+        prev->count -= move;
+        Last->count += move;
+      }
+
+      // the nodes of one level with the smallest key of their subtree
+      std::vector< std::pair< node_base*, const Key* > > level;
+      for ( auto leaf = First; leaf != nullptr; leaf = leaf->next )
+        level.push_back( { leaf, std::addressof( leaf->keys[0] ) } );
+
+      Height = 0;
+      Root   = level.empty() ? nullptr : level[0].first;
+
+      constexpr size_t full = inner_capacity + 1;
+
+      while ( level.size() > 1 ) {
+        // full nodes, the last two share the rest if the last one would be too small
+        const size_t groups = ( level.size() + full - 1 ) / full;
+        size_t last_size    = level.size() - ( groups - 1 ) * full;
+        size_t before_last  = full;
+
+        if ( groups > 1 && last_size < min_inner + 1 ) {
+          const size_t total = full + last_size;
+          last_size          = total / 2;
+          before_last        = total - last_size;
+        }
+
+        std::vector< std::pair< node_base*, const Key* > > parents;
+        parents.reserve( groups );
+
+        for ( size_t group = 0, next = 0; group < groups; ++group ) {
+          const size_t size = group + 1 == groups ? last_size
+                              : group + 2 == groups ? before_last
+                                                    : full;
+
+          inner_node* node = inners.create();
+          node->count      = size - 1;
+
+          for ( size_t i = 0; i < size; ++i ) {
+            node->children[i] = level[next + i].first;
+            if ( i > 0 )
+              node->keys[i - 1] = *level[next + i].second;
+          }
+
+          parents.push_back( { node, level[next].second } );
+          next += size;
+        }
+
+        level = std::move( parents );
+        Root  = level[0].first;
+        ++Height;
+      }
+    }
+
+    void destroy_subtree( node_base* node, size_t level ) noexcept {
+      if ( level == 0 ) {
+        leaves.destroy( as_leaf( node ) );
+        return;
+      }
+
+      inner_node* inner = as_inner( node );
+      for ( size_t i = 0; i <= inner->count; ++i )
+        destroy_subtree( inner->children[i], level - 1 );
+
+      inners.destroy( inner );
+    }
+
+    // the memory itself is freed by the pools
+    void destroy_nodes() noexcept {
+      if constexpr ( !std::is_trivially_destructible_v< leaf_node > ||
+                     !std::is_trivially_destructible_v< inner_node > )
+        if ( Root != nullptr )
+          destroy_subtree( Root, Height );
+
+      Root = First = Last = nullptr;
+      Count = Height = 0;
+    }
+  };
+
+  template < typename Key, typename T, typename Compare = std::less< Key >,
+             size_t Node_size = 0x100 >
+  using btree_map = btree< Key, T, Compare, Node_size >;
+
+  template < typename Key, typename Compare = std::less< Key >, size_t Node_size = 0x100 >
+  using btree_set = btree< Key, void, Compare, Node_size >;
+} // namespace ds
+
+// a reference and a copy of a map element meet in the copy, as the
+// iterator concepts require
+template < typename Key, typename Value, typename T, template < typename > typename TQual,
+           template < typename > typename UQual >
+  requires std::same_as< std::remove_const_t< Value >, T >
+struct std::basic_common_reference< ds::detail::btree_reference< Key, Value >, std::pair< Key, T >,
+                                    TQual, UQual > {
+  using type = std::pair< Key, T >;
+};
+
+template < typename Key, typename Value, typename T, template < typename > typename TQual,
+           template < typename > typename UQual >
+  requires std::same_as< std::remove_const_t< Value >, T >
+struct std::basic_common_reference< std::pair< Key, T >, ds::detail::btree_reference< Key, Value >,
+                                    TQual, UQual > {
+  using type = std::pair< Key, T >;
+};
@@ -1,15 +1,24 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 #include "../Nodes/node.hpp"
 #include "block.hpp"
+#include "growth_policy.hpp"
+#include "node_pool.hpp"
 
 namespace ds {
-  template < typename T, typename Node = void >
+  template < typename T, typename Node = void, growth_policy Growth = growth::geometric<>,
+             typename Alloc = std::allocator< T > >
   class data_manager {
   public:
-    using block_type = block< T >;
+    using block_type     = block< T, 0x800, Alloc >;
+    using growth         = Growth;
+    using allocator_type = typename block_type::allocator_type;
 
     using value_type      = typename block_type::value_type;
     using reference       = typename block_type::reference;
@@ -19,21 +28,50 @@ namespace ds {
     using iterator         = typename block_type::iterator;
     using reverse_iterator = typename block_type::reverse_iterator;
 
+    using segments_type       = segment_range< block_type >;
+    using const_segments_type = segment_range< const block_type, const value_type >;
+
   private:
-    size_t Block_count = 10, Size = 0;
+    static constexpr size_t block_elements = block_type::num_elements;
+
+    // the blocks live in elems[Front, Front + Size), the table slots before
+    // them are kept free so blocks can be added in front without moving the rest
+    size_t Block_count = 10, Size = 0, Front = 0;
     std::unique_ptr< block_type[] > elems = std::make_unique< block_type[] >( Block_count );
+    [[no_unique_address]] allocator_type alloc{};
+
+    block_type& block_at( size_t index ) noexcept { return elems[Front + index]; }
+
+    const block_type& block_at( size_t index ) const noexcept { return elems[Front + index]; }
+
+    // moves n values starting at 'from' to 'to' inside one block, the ranges may overlap
+    static void move_within( pointer from, pointer to, size_t n ) {
+      if constexpr ( std::is_trivially_copyable_v< value_type > )
+        std::memmove( static_cast< void* >( to ), static_cast< const void* >( from ),
+                      n * sizeof( value_type ) );
+      else if ( to < from )
+        std::move( from, from + n, to );
+      else
+        std::move_backward( from, from + n, to + n );
+    }
 
   public:
-    data_manager() { elems[Size++] = block_type( value_type() ); }
+    data_manager() { elems[Size++] = block_type( uninitialized, alloc ); }
+
+    explicit data_manager( const allocator_type& a ) : alloc( a ) {
+      elems[Size++] = block_type( uninitialized, alloc );
+    }
 
     data_manager( const data_manager& other ) :
-        Block_count( other.Block_count ), Size( other.Size ) {
+        Block_count( other.Block_count ), Size( other.Size ), Front( other.Front ),
+        alloc( other.alloc ) {
       elems = std::make_unique< block_type[] >( Block_count );
       std::copy( other.elems.get(), other.elems.get() + Block_count, elems.get() );
     }
 
     data_manager( data_manager&& dm ) :
-        elems( std::move( dm.elems ) ), Block_count( dm.Block_count ), Size( dm.Size ) { }
+        Block_count( dm.Block_count ), Size( dm.Size ), Front( dm.Front ),
+        elems( std::move( dm.elems ) ), alloc( dm.alloc ) { }
 
     data_manager& operator=( const data_manager& dm ) {
       elems = std::make_unique< block_type[] >( dm.Block_count );
@@ -41,6 +79,8 @@ namespace ds {
 
       Block_count = dm.Block_count;
       Size        = dm.Size;
+      Front       = dm.Front;
+      alloc       = dm.alloc;
 
       return *this;
     }
@@ -49,95 +89,222 @@ namespace ds {
       elems       = std::move( dm.elems );
       Block_count = dm.Block_count;
       Size        = dm.Size;
+      Front       = dm.Front;
+      alloc       = dm.alloc;
 
       return *this;
     }
 
-    [[deprecated]] void insert( const value_type& val ) {
-      auto iter = find_space();
-      if ( iter != end() )
-        *iter = val;
-      else if ( Size < Block_count ) {
-        elems[Size++] = block_type( value_type() );
-        ++( --iter );
-        *iter = std::move( val );
-      } else {
-        resize( Block_count + 10 );
-        elems[Size++] = block_type( value_type() );
-        ++( --iter );
-        *iter = val;
-      }
-    }
-
-    [[deprecated]] void insert( value_type&& val ) {
-      auto iter = find_space();
-      if ( iter != end() )
-        *iter = std::move( val );
-      else if ( Size < Block_count ) {
-        ++( --iter );
-        *iter = std::move( val );
-      } else {
-        resize( Block_count + 10 );
-        ++( --iter );
-        *iter = std::move( val );
-      }
-    }
-
     value_type& operator[]( size_t index ) {
-      if ( index >= Size * block_type::num_elements )
-        expand_by( index / block_type::num_elements - Size + 1 );
+      if ( index >= Size * block_elements )
+        expand_by( index / block_elements - Size + 1 );
 
-      const auto block_index = index / block_type::num_elements;
-      const auto value_index = index % block_type::num_elements;
-      return elems[block_index][value_index];
+      const auto block_index = index / block_elements;
+      const auto value_index = index % block_elements;
+      return block_at( block_index )[value_index];
     }
 
     const value_type& operator[]( size_t index ) const {
-      const auto block_index = index / block_type::num_elements;
-      const auto value_index = index % block_type::num_elements;
-      return elems[block_index][value_index];
+      const auto block_index = index / block_elements;
+      const auto value_index = index % block_elements;
+      return block_at( block_index )[value_index];
     }
 
-    void resize( size_t new_block_count ) {
+    // moves the blocks into a table of new_block_count slots, new_front of them
+    // are left free in front of the blocks
+    void resize( size_t new_block_count, size_t new_front = 0 ) {
       std::unique_ptr< block_type[] > tmp = std::make_unique< block_type[] >( new_block_count );
 
-      for ( size_t i = 0; i < new_block_count && i < Block_count; i++ )
-        tmp[i] = std::move( elems[i] );
+      for ( size_t i = 0; i + new_front < new_block_count && i < Size; i++ )
+        tmp[new_front + i] = std::move( block_at( i ) );
 
       Block_count = new_block_count;
+      Size        = std::min( Size, new_block_count - std::min( new_front, new_block_count ) );
+      Front       = new_front;
       elems       = std::move( tmp );
     }
 
+    // reserves table space for 'blocks' blocks, expand_by allocates them
+    void reserve( size_t blocks ) {
+      if ( Front + blocks > Block_count )
+        resize( Front + blocks, Front );
+    }
+
+    // the table grows according to the growth policy, so a sequence of
+    // expand_by( 1 ) calls only moves the block table O(log n) times
     void expand_by( size_t blocks ) {
-      if ( Size + blocks >= Block_count )
-        resize( Block_count + blocks );
+      if ( Front + Size + blocks > Block_count )
+        resize( Growth::next_capacity( Block_count, Front + Size + blocks ), Front );
+
+      for ( ; blocks > 0; --blocks ) {
+        block_at( Size++ ) = block_type( uninitialized, alloc );
+      }
+    }
+
+    // adds blocks in front of the first one. Every index shifts by
+    // blocks * block_type::num_elements, iterators are invalidated.
+    void expand_front_by( size_t blocks ) {
+      if ( Front < blocks ) {
+        const auto back_room = Block_count - Front - Size;
+        const auto capacity  = Growth::next_capacity( Block_count, Size + blocks + back_room );
+        resize( capacity, capacity - Size - back_room );
+      }
 
       for ( ; blocks > 0; --blocks ) {
-        elems[Size++] = block_type( value_type() );
+        elems[--Front] = block_type( uninitialized, alloc );
+        ++Size;
       }
     }
 
-    [[deprecated]] iterator find_space() const noexcept {
-      auto iter = begin();
-      auto last = end();
+    // constructs the value at 'index', the slot must not hold a value yet
+    template < typename... Args >
+    reference emplace( size_t index, Args&&... args ) {
+      if ( index >= Size * block_elements )
+        expand_by( index / block_elements - Size + 1 );
 
-      for ( ; iter != last; ++iter ) {
-        if ( *iter == value_type() )
-          return iter;
+      const auto block_index = index / block_elements;
+      const auto value_index = index % block_elements;
+      return block_at( block_index ).emplace( value_index, std::forward< Args >( args )... );
+    }
+
+    // makes sure the slots [0, slots) are backed by blocks, growing the table once
+    void expand_to( size_t slots ) {
+      const auto blocks = ( slots + block_elements - 1 ) / block_elements;
+
+      if ( blocks > Size )
+        expand_by( blocks - Size );
+    }
+
+    // constructs the slots [index, index + count) from the values at 'src', one
+    // block at a time. Returns the iterator past the last value read.
+    template < typename InputIt >
+    InputIt construct_n( size_t index, InputIt src, size_t count ) {
+      expand_to( index + count );
+
+      const auto start = index;
+      try {
+        while ( count > 0 ) {
+          const auto value_index = index % block_elements;
+          const auto n           = std::min( count, block_elements - value_index );
+
+          src = block_at( index / block_elements ).construct_n( value_index, src, n );
+          index += n;
+          count -= n;
+        }
+      } catch ( ... ) {
+        destroy_n( start, index );
+        throw;
+      }
+
+      return src;
+    }
+
+    // constructs the slots [index, index + count) as copies of 'val'
+    void fill_n( size_t index, size_t count, const value_type& val ) {
+      expand_to( index + count );
+
+      const auto start = index;
+      try {
+        while ( count > 0 ) {
+          const auto value_index = index % block_elements;
+          const auto n           = std::min( count, block_elements - value_index );
+
+          block_at( index / block_elements ).fill_n( value_index, n, val );
+          index += n;
+          count -= n;
+        }
+      } catch ( ... ) {
+        destroy_n( start, index );
+        throw;
+      }
+    }
+
+    // destroys the values in the slots [first, last), which have to be at the
+    // front or the back of the stored values
+    void destroy_n( size_t first, size_t last ) noexcept {
+      while ( first < last ) {
+        const auto value_index = first % block_elements;
+        const auto n           = std::min( last - first, block_elements - value_index );
+
+        block_at( first / block_elements ).destroy_n( value_index, n );
+        first += n;
       }
+    }
 
-      return last;
+    // destroys the value at 'index', the slot can be reused by emplace afterwards
+    void destroy( size_t index ) noexcept {
+      const auto block_index = index / block_elements;
+      const auto value_index = index % block_elements;
+      block_at( block_index ).destroy( value_index );
     }
 
-    constexpr size_t size() const noexcept { return static_cast< size_t >( end() - begin() ); }
+    // destroys every value, the blocks stay allocated
+    void clear() noexcept {
+      for ( size_t i = 0; i < Size; ++i )
+        block_at( i ).clear();
+    }
+
+    // moves the values of the slots [first, last) one slot towards the back,
+    // slot 'last' has to hold a value already. Works block by block, trivially
+    // copyable values are moved with memmove.
+    void move_back( size_t first, size_t last ) {
+      while ( last > first ) {
+        const auto begin = std::max( first, ( last - 1 ) / block_elements * block_elements );
+        const auto count = last - 1 - begin;
+
+        ( *this )[last] = std::move( ( *this )[last - 1] );
 
-    constexpr iterator begin() const noexcept { return elems[0].begin(); }
+        if ( count > 0 ) {
+          const auto from = std::addressof( ( *this )[begin] );
+          move_within( from, from + 1, count );
+        }
 
-    constexpr iterator begin() noexcept { return elems[0].begin(); }
+        last = begin;
+      }
+    }
 
-    constexpr reverse_iterator rend() const noexcept { return elems[0].rend(); }
+    // moves the values of the slots [first, last) one slot towards the front,
+    // slot 'first - 1' has to hold a value already
+    void move_front( size_t first, size_t last ) {
+      while ( first < last ) {
+        const auto end   = std::min( last, ( first / block_elements + 1 ) * block_elements );
+        const auto count = end - first - 1;
 
-    constexpr reverse_iterator rend() noexcept { return elems[0].rend(); }
+        ( *this )[first - 1] = std::move( ( *this )[first] );
+
+        if ( count > 0 ) {
+          const auto to = std::addressof( ( *this )[first] );
+          move_within( to + 1, to, count );
+        }
+
+        first = end;
+      }
+    }
+
+    constexpr size_t size() const noexcept { return Size * block_elements; }
+
+    constexpr size_t block_count() const noexcept { return Size; }
+
+    allocator_type get_allocator() const noexcept { return alloc; }
+
+    // the slots [first, last) as contiguous spans, one per block
+    segments_type segments( size_t first, size_t last ) noexcept {
+      return segments_type( elems.get() + Front, first, last );
+    }
+
+    const_segments_type segments( size_t first, size_t last ) const noexcept {
+      return const_segments_type( elems.get() + Front, first, last );
+    }
+
+    constexpr size_t block_capacity() const noexcept { return Block_count; }
+
+    constexpr iterator begin() const noexcept { return elems[Front].begin(); }
+
+    constexpr iterator begin() noexcept { return elems[Front].begin(); }
+
+    constexpr reverse_iterator rend() const noexcept { return elems[Front].rend(); }
+
+    constexpr reverse_iterator rend() noexcept { return elems[Front].rend(); }
 
     constexpr iterator iterator_at( size_t index ) noexcept { return begin() + index; }
 
@@ -149,136 +316,258 @@ namespace ds {
       return rbegin() + index;
     }
 
-    constexpr iterator end() const noexcept { return elems[Size - 1].end(); }
+    constexpr iterator end() const noexcept { return elems[Front + Size - 1].end(); }
 
-    constexpr iterator end() noexcept { return elems[Size - 1].end(); }
+    constexpr iterator end() noexcept { return elems[Front + Size - 1].end(); }
 
-    constexpr reverse_iterator rbegin() const noexcept { return elems[Size - 1].rbegin(); }
+    constexpr reverse_iterator rbegin() const noexcept { return elems[Front + Size - 1].rbegin(); }
 
-    constexpr reverse_iterator rbegin() noexcept { return elems[Size - 1].rbegin(); }
+    constexpr reverse_iterator rbegin() noexcept { return elems[Front + Size - 1].rbegin(); }
   };
 
-  template < typename T >
-  class data_manager< T, duo_node< T > > {
+  template < typename T, growth_policy Growth, typename Alloc >
+  class data_manager< T, duo_node< T >, Growth, Alloc > {
   public:
     using value_type = T;
     using node_type  = duo_node< T >;
+    using growth     = Growth;
 
     using iterator = iterators::bi_traverse_iterator< T >;
 
   private:
-    size_t Size      = 10;
-    node_type* elems = nullptr;
-    iterator Begin;
+    using pool_type = node_pool< node_type, Growth,
+                                 typename std::allocator_traits< Alloc >::template rebind_alloc<
+                                   node_type > >;
+
+    // the nodes live in a chunked pool, growing it never moves a node, so
+    // iterators stay valid until their node is erased
+    size_t Count     = 0;
+    node_type* First = nullptr;
+    node_type* Last  = nullptr;
+    pool_type pool;
 
   public:
-    data_manager() : Size( 10 ), elems( new node_type[Size] ), Begin( &elems[0] ) {
-      init( elems, Size );
-    }
+    data_manager() = default;
 
-    data_manager( data_manager&& dm ) : Size( dm.size ), elems( dm.elems ) {
-      dm.elems = nullptr;
-      Begin    = dm.Begin;
-    }
+    explicit data_manager( const Alloc& alloc ) : pool( alloc ) { }
 
-    data_manager& operator=( data_manager&& dm ) {
-      Size = dm.size;
-      delete[] elems;
-      elems    = dm.elems;
-      dm.elems = nullptr;
-      Begin    = dm.Begin;
+    data_manager( data_manager&& dm ) noexcept :
+        Count( std::exchange( dm.Count, 0 ) ), First( std::exchange( dm.First, nullptr ) ),
+        Last( std::exchange( dm.Last, nullptr ) ), pool( std::move( dm.pool ) ) { }
+
+    data_manager& operator=( data_manager&& dm ) noexcept {
+      std::swap( Count, dm.Count );
+      std::swap( First, dm.First );
+      std::swap( Last, dm.Last );
+      std::swap( pool, dm.pool );
       return *this;
     }
 
     data_manager( const data_manager& ) = delete;
     data_manager& operator=( const data_manager& ) = delete;
 
-    void insert( const value_type& val, size_t index ) {
-      if ( index >= Size )
-        resize( Size + 10 );
+    void insert( const value_type& val, size_t index ) { emplace( index, val ); }
 
-      iterator iter = begin();
-      for ( ; index > 0; index-- )
-        iter++;
+    void insert( value_type&& val, size_t index ) { emplace( index, std::move( val ) ); }
+
+    void insert( const value_type& val, iterator pos ) { emplace( pos, val ); }
 
-      insert( val, iter );
+    void insert( value_type&& val, iterator pos ) { emplace( pos, std::move( val ) ); }
+
+    template < typename... Args >
+    iterator emplace( size_t index, Args&&... args ) {
+      return emplace( iterator_at( index ), std::forward< Args >( args )... );
+    }
+
+    // constructs the value inside a new node and links it in front of 'pos'
+    template < typename... Args >
+    iterator emplace( iterator pos, Args&&... args ) {
+      node_type* node = pool.create( std::in_place, std::forward< Args >( args )... );
+
+      node_type* next = pos.get();
+      node_type* prev = next != nullptr ? next->prev : Last;
+
+      node->prev = prev;
+      node->next = next;
+      ( prev != nullptr ? prev->next : First ) = node;
+      ( next != nullptr ? next->prev : Last )  = node;
+
+      ++Count;
+      return iterator( node );
     }
 
-    void insert( value_type&& val, size_t index ) {
-      if ( index >= Size )
-        resize( Size + 10 );
+    value_type& at( size_t index ) {
+      iterator iter = iterator_at( index );
+      assert( iter.get() != nullptr );
+      return iter->value;
+    }
 
+    const value_type& at( size_t index ) const {
+      iterator iter = iterator_at( index );
+      assert( iter.get() != nullptr );
+      return iter->value;
+    }
+
+    bool erase( const value_type& val ) {
       iterator iter = begin();
-      for ( ; index > 0; index-- )
-        iter++;
+      for ( ; iter != end(); iter++ )
+        if ( iter->value == val )
+          break;
 
-      insert( std::forward< value_type >( val ), iter );
+      return erase( iter );
     }
 
-    void insert( const value_type& val, iterator pos ) {
-      size_t index = find_space();
-      if ( index == Size ) {
-        size_t iter_index = 0;
-        while ( pos != Begin ) {
-          iter_index++;
-          pos--;
-        }
-        resize( Size + 10 );
-        pos = iterator( std::addressof( elems[iter_index] ) );
-      }
+    // unlinks the node at 'pos' and gives it back to the pool
+    bool erase( iterator pos ) {
+      node_type* node = pos.get();
+      if ( node == nullptr )
+        return false;
 
-      if ( *Begin != node_type() && pos != Begin ) {
-        iterator prev = pos;
-        --prev;
-        link_nodes( prev, iterator( std::addressof( elems[index] ) ) );
-        link_nodes( iterator( std::addressof( elems[index] ) ), *pos );
-      } else if ( *Begin != node_type() && pos == Begin ) {
-        link_nodes( elems[index], *pos );
-        Begin       = iterator( std::addressof( elems[index] ) );
-        Begin->prev = nullptr;
-      }
+      ( node->prev != nullptr ? node->prev->next : First ) = node->next;
+      ( node->next != nullptr ? node->next->prev : Last )  = node->prev;
+
+      pool.destroy( node );
 
-      elems[index].value = val;
+      --Count;
+      return true;
     }
 
-    void insert( value_type&& val, iterator pos ) {
-      size_t index = find_space();
-      if ( index == Size ) {
-        size_t iter_index = 0;
-        while ( pos != Begin ) {
-          iter_index++;
-          pos--;
-        }
-        resize( Size + 10 );
-        pos = iterator( std::addressof( elems[iter_index] ) );
-      }
+    // reserves room for new_size nodes, no node is moved
+    void resize( size_t new_size ) {
+      if ( new_size > Count )
+        pool.reserve( new_size - Count );
+    }
 
-      if ( *Begin.get() != node_type() && pos != Begin ) {
-        iterator prev = pos;
-        --prev;
-        link_nodes( prev, iterator( std::addressof( elems[index] ) ) );
-        link_nodes( iterator( std::addressof( elems[index] ) ), pos );
-      } else if ( pos == Begin && *Begin.get() != node_type() ) {
-        link_nodes( elems[index], *pos.get() );
-        Begin       = iterator( std::addressof( elems[index] ) );
-        Begin->prev = nullptr;
-      }
+    void clear() noexcept {
+      destroy_nodes();
+      pool.release();
+    }
+
+    static void link_nodes( node_type& n1, node_type& n2 ) {
+      n1.next = std::addressof( n2 );
+      n2.prev = std::addressof( n1 );
+    }
+
+    size_t size() const { return Count; }
+
+    size_t capacity() const { return pool.capacity(); }
+
+    iterator iterator_at( size_t index ) const {
+      node_type* node = First;
+      for ( ; index > 0 && node != nullptr; --index )
+        node = node->next;
+
+      return iterator( node );
+    }
+
+    iterator begin() const { return iterator( First ); }
+
+    iterator begin() { return iterator( First ); }
+
+    iterator end() const { return iterator(); }
+
+    iterator end() { return iterator(); }
+
+    ~data_manager() { destroy_nodes(); }
+
+  private:
+    void destroy_nodes() noexcept {
+      if constexpr ( !std::is_trivially_destructible_v< node_type > )
+        for ( node_type* node = First; node != nullptr; )
+          std::destroy_at( std::exchange( node, node->next ) );
+
+      Count = 0;
+      First = Last = nullptr;
+    }
+  };
+
+  // list manager that keeps an order statistic tree over the nodes, so access,
+  // insertion and erasure by index are O(log n) ( expected ) instead of O(n).
+  // Iteration still follows the prev / next links.
+  template < typename T, growth_policy Growth, typename Alloc >
+  class data_manager< T, indexed_node< T >, Growth, Alloc > {
+  public:
+    using value_type = T;
+    using node_type  = indexed_node< T >;
+    using growth     = Growth;
+
+    using iterator = iterators::bi_traverse_iterator< T, node_type >;
+
+  private:
+    using pool_type = node_pool< node_type, Growth,
+                                 typename std::allocator_traits< Alloc >::template rebind_alloc<
+                                   node_type > >;
+
+    size_t Count     = 0;
+    node_type* First = nullptr;
+    node_type* Last  = nullptr;
+    node_type* Root  = nullptr;
+    size_t Seed      = 0x9e3779b97f4a7c15;
+    pool_type pool;
+
+  public:
+    data_manager() = default;
+
+    explicit data_manager( const Alloc& alloc ) : pool( alloc ) { }
+
+    data_manager( data_manager&& dm ) noexcept :
+        Count( std::exchange( dm.Count, 0 ) ), First( std::exchange( dm.First, nullptr ) ),
+        Last( std::exchange( dm.Last, nullptr ) ), Root( std::exchange( dm.Root, nullptr ) ),
+        Seed( dm.Seed ), pool( std::move( dm.pool ) ) { }
+
+    data_manager& operator=( data_manager&& dm ) noexcept {
+      std::swap( Count, dm.Count );
+      std::swap( First, dm.First );
+      std::swap( Last, dm.Last );
+      std::swap( Root, dm.Root );
+      std::swap( Seed, dm.Seed );
+      std::swap( pool, dm.pool );
+      return *this;
+    }
+
+    data_manager( const data_manager& ) = delete;
+    data_manager& operator=( const data_manager& ) = delete;
+
+    void insert( const value_type& val, size_t index ) { emplace( index, val ); }
+
+    void insert( value_type&& val, size_t index ) { emplace( index, std::move( val ) ); }
+
+    void insert( const value_type& val, iterator pos ) { emplace( pos, val ); }
+
+    void insert( value_type&& val, iterator pos ) { emplace( pos, std::move( val ) ); }
 
-      elems[index].value = std::move( val );
+    template < typename... Args >
+    iterator emplace( size_t index, Args&&... args ) {
+      return emplace( iterator_at( index ), std::forward< Args >( args )... );
+    }
+
+    // constructs the value inside a new node and links it in front of 'pos'
+    template < typename... Args >
+    iterator emplace( iterator pos, Args&&... args ) {
+      node_type* node = pool.create( std::in_place, std::forward< Args >( args )... );
+
+      node_type* next = pos.get();
+      node_type* prev = next != nullptr ? next->prev : Last;
+
+      node->prev = prev;
+      node->next = next;
+      ( prev != nullptr ? prev->next : First ) = node;
+      ( next != nullptr ? next->prev : Last )  = node;
+
+      tree_insert( node );
+
+      ++Count;
+      return iterator( node );
     }
 
     value_type& at( size_t index ) {
-      iterator iter = Begin;
-      for ( size_t i = 0; i < index && iter != end(); i++ )
-        ++iter;
+      iterator iter = iterator_at( index );
       assert( iter.get() != nullptr );
       return iter->value;
     }
 
     const value_type& at( size_t index ) const {
-      iterator iter = Begin;
-      for ( size_t i = 0; i < index && iter != end(); i++ )
-        ++iter;
+      iterator iter = iterator_at( index );
       assert( iter.get() != nullptr );
       return iter->value;
     }
@@ -293,93 +582,174 @@ namespace ds {
     }
 
     bool erase( iterator pos ) {
-      if ( pos.get() != nullptr ) {
-        iterator prev = pos, next = pos;
-        --prev;
-        ++next;
-        if ( !link_nodes( prev, next ) && prev.get() == nullptr )
-          Begin = next;
-        *pos.get() = node_type();
-        return true;
-      }
-      return false;
+      node_type* node = pos.get();
+      if ( node == nullptr )
+        return false;
+
+      ( node->prev != nullptr ? node->prev->next : First ) = node->next;
+      ( node->next != nullptr ? node->next->prev : Last )  = node->prev;
+
+      tree_erase( node );
+      pool.destroy( node );
+
+      --Count;
+      return true;
+    }
+
+    // reserves room for new_size nodes, no node is moved
+    void resize( size_t new_size ) {
+      if ( new_size > Count )
+        pool.reserve( new_size - Count );
+    }
+
+    void clear() noexcept {
+      destroy_nodes();
+      pool.release();
     }
 
-    static void check_linkage( node_type* node, size_t size ) {
-      for ( size_t i = 0; i < size; i++ ) {
-        if ( node[i].next == std::addressof( node[i] ) )
-          node[i].next = nullptr;
+    size_t size() const { return Count; }
+
+    size_t capacity() const { return pool.capacity(); }
+
+    // returns end() for index >= size()
+    iterator iterator_at( size_t index ) const {
+      node_type* node = Root;
+      while ( node != nullptr ) {
+        const size_t left = count_of( node->left );
+
+        if ( index == left )
+          break;
 
-        if ( node[i].prev == std::addressof( node[i] ) )
-          node[i].prev = nullptr;
+        if ( index < left ) {
+          node = node->left;
+        } else {
+          index -= left + 1;
+          node = node->right;
+        }
       }
+
+      return iterator( node );
     }
 
-    bool is_in_bound( node_type* node ) const { return node >= elems && node < elems + Size; }
+    // position of the node at 'pos', size() for end()
+    size_t index_of( iterator pos ) const {
+      const node_type* node = pos.get();
+      if ( node == nullptr )
+        return Count;
 
-    static void init( node_type* ptr, size_t size ) {
-      for ( size_t i = 0; i < size; i++ )
-        ptr[i] = node_type();
+      size_t index = count_of( node->left );
+      for ( ; node->parent != nullptr; node = node->parent )
+        if ( node == node->parent->right )
+          index += count_of( node->parent->left ) + 1;
+
+      return index;
     }
 
-    void resize( size_t new_size ) {
-      node_type* tmp = new node_type[new_size];
-      init( tmp, new_size );
-      iterator iter = begin();
+    iterator begin() const { return iterator( First ); }
 
-      for ( size_t i = 0; i < new_size && iter != end(); i++ ) {
-        tmp[i].value = std::move( iter->value );
-        if ( i != 0 )
-          link_nodes( tmp[i - 1], tmp[i] );
+    iterator begin() { return iterator( First ); }
 
-        ++iter;
-      }
+    iterator end() const { return iterator(); }
+
+    iterator end() { return iterator(); }
+
+    ~data_manager() { destroy_nodes(); }
 
-      Size = new_size;
-      delete[] elems;
-      elems = tmp;
-      Begin = iterator( std::addressof( tmp[0] ) );
+  private:
+    static size_t count_of( const node_type* node ) noexcept {
+      return node != nullptr ? node->count : 0;
     }
 
-    void link_nodes( node_type& n1, node_type& n2 ) {
-      n1.next = std::addressof( n2 );
-      n2.prev = std::addressof( n1 );
+    // splitmix64, the tree only needs the priorities to look random
+    size_t next_priority() noexcept {
+      uint64_t z = ( Seed += 0x9e3779b97f4a7c15 );
+      z          = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9;
+      z          = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111eb;
+      return static_cast< size_t >( z ^ ( z >> 31 ) );
     }
 
-    bool link_nodes( iterator prev, iterator next ) {
-      if ( is_in_bound( prev.get() ) && is_in_bound( next.get() ) ) {
-        prev->next = next.get();
-        next->prev = prev.get();
-        return true;
-      }
-      return false;
+    void replace_child( node_type* parent, node_type* old_child, node_type* new_child ) noexcept {
+      if ( parent == nullptr )
+        Root = new_child;
+      else if ( parent->left == old_child )
+        parent->left = new_child;
+      else
+        parent->right = new_child;
+
+      if ( new_child != nullptr )
+        new_child->parent = parent;
     }
 
-    size_t find_space() const {
-      for ( size_t i = 0; i < Size; i++ ) {
-        if ( elems[i] == node_type() )
-          return i;
+    // moves 'node' above its parent without changing the in-order sequence
+    void rotate_up( node_type* node ) noexcept {
+      node_type* parent = node->parent;
+      replace_child( parent->parent, parent, node );
+
+      if ( parent->left == node ) {
+        parent->left = node->right;
+        if ( node->right != nullptr )
+          node->right->parent = parent;
+        node->right = parent;
+      } else {
+        parent->right = node->left;
+        if ( node->left != nullptr )
+          node->left->parent = parent;
+        node->left = parent;
       }
 
-      return Size;
+      parent->parent = node;
+      node->count    = parent->count;
+      parent->count  = 1 + count_of( parent->left ) + count_of( parent->right );
     }
 
-    size_t size() const { return Size; }
+    // 'node' is already linked into the list, its list neighbours tell where
+    // it belongs in the tree: the left slot of its successor if that is free,
+    // otherwise the right slot of its predecessor ( which is free then )
+    void tree_insert( node_type* node ) noexcept {
+      node->left = node->right = nullptr;
+      node->count              = 1;
+      node->priority           = next_priority();
+
+      if ( Root == nullptr ) {
+        node->parent = nullptr;
+        Root         = node;
+        return;
+      }
 
-    iterator begin() const {
-      // check_linkage(elems, _size);
-      return iterator( Begin );
-    }
+      if ( node->next != nullptr && node->next->left == nullptr ) {
+        node->next->left = node;
+        node->parent     = node->next;
+      } else {
+        node->prev->right = node;
+        node->parent      = node->prev;
+      }
+
+      for ( node_type* p = node->parent; p != nullptr; p = p->parent )
+        ++p->count;
 
-    iterator begin() {
-      // check_linkage(elems, _size);
-      return iterator( Begin );
+      while ( node->parent != nullptr && node->parent->priority < node->priority )
+        rotate_up( node );
     }
 
-    iterator end() const { return iterator(); }
+    void tree_erase( node_type* node ) noexcept {
+      // rotate the node down until it has at most one child
+      while ( node->left != nullptr && node->right != nullptr )
+        rotate_up( node->left->priority > node->right->priority ? node->left : node->right );
 
-    iterator end() { return iterator(); }
+      node_type* parent = node->parent;
+      replace_child( parent, node, node->left != nullptr ? node->left : node->right );
+
+      for ( ; parent != nullptr; parent = parent->parent )
+        --parent->count;
+    }
 
-    ~data_manager() { delete[] elems; }
+    void destroy_nodes() noexcept {
+      if constexpr ( !std::is_trivially_destructible_v< node_type > )
+        for ( node_type* node = First; node != nullptr; )
+          std::destroy_at( std::exchange( node, node->next ) );
+
+      Count = 0;
+      First = Last = Root = nullptr;
+    }
   };
 } // namespace ds
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+
+#include "../Types.hpp"
+
+namespace ds {
+  // a growth policy decides how many blocks (or nodes) a manager reserves
+  // when it runs out of space. next_capacity always returns at least 'required'.
+  template < typename G >
+  concept growth_policy = requires( size_t current, size_t required ) {
+    { G::next_capacity( current, required ) }
+    ->std::same_as< size_t >;
+  };
+
+  namespace growth {
+    // multiplies the capacity by Num / Den ( amortized O(1) per added block )
+    template < size_t Num = 2, size_t Den = 1 >
+    struct geometric {
+      static_assert( Den != 0 && Num > Den, "geometric growth needs a factor greater than 1" );
+
+      static constexpr size_t next_capacity( size_t current, size_t required ) noexcept {
+        return std::max( current * Num / Den + 1, required );
+      }
+    };
+
+    // adds Step to the capacity ( the old behaviour, O(n) per added block )
+    template < size_t Step = 10 >
+    struct fixed_step {
+      static_assert( Step != 0, "fixed_step growth needs a step greater than 0" );
+
+      static constexpr size_t next_capacity( size_t current, size_t required ) noexcept {
+        return std::max( current + Step, required );
+      }
+    };
+
+    // asks a user supplied function: Func( current, required ) -> new capacity
+    template < function_pointer< size_t, size_t, size_t > Func >
+    struct callback {
+      static size_t next_capacity( size_t current, size_t required ) {
+        return std::max( Func( current, required ), required );
+      }
+    };
+  } // namespace growth
+} // namespace ds
@@ -21,11 +21,8 @@ namespace ds {
   public:
     list() = default;
 
-    list( const value_type& t ) {
-      data.insert( t );
-      num_elements++;
-    }
-    
+    list( const value_type& t ) { emplace( size_t( 0 ), t ); }
+
     void insert( const value_type& t, size_t index = 0 ) {
       data.insert( t, index );
       ++num_elements;
@@ -48,6 +45,32 @@ namespace ds {
       ++num_elements;
     }
 
+    // the emplace functions construct the value inside its node and return an
+    // iterator to it
+    template < typename... Args >
+    iterator emplace( size_t index, Args&&... args ) {
+      auto pos = data.emplace( index, std::forward< Args >( args )... );
+      ++num_elements;
+      return pos;
+    }
+
+    template < typename... Args >
+    iterator emplace( iterator iter, Args&&... args ) {
+      auto pos = data.emplace( iter, std::forward< Args >( args )... );
+      ++num_elements;
+      return pos;
+    }
+
+    template < typename... Args >
+    iterator emplace_front( Args&&... args ) {
+      return emplace( begin(), std::forward< Args >( args )... );
+    }
+
+    template < typename... Args >
+    iterator emplace_back( Args&&... args ) {
+      return emplace( end(), std::forward< Args >( args )... );
+    }
+
     value_type& operator[]( size_t index ) { return data.at( index ); }
 
     const value_type& operator[]( size_t index ) const { return data.at( index ); }
@@ -62,8 +85,16 @@ namespace ds {
         --num_elements;
     }
 
+    void erase_at( size_t index ) { erase( data.iterator_at( index ) ); }
+
+    // reserves room for new_size elements, iterators stay valid
     void resize( size_t new_size ) { data.resize( new_size ); }
 
+    void clear() noexcept {
+      data.clear();
+      num_elements = 0;
+    }
+
     bool is_empty() const { return num_elements == 0; }
 
     size_t size() const { return num_elements; }
@@ -77,4 +108,8 @@ namespace ds {
 
     iterator end() const { return data.end(); }
   };
+
+  // list with O(log n) access, insertion and erasure by index
+  template < typename T >
+  using indexed_list = list< T, data_manager< T, indexed_node< T > > >;
 } // namespace ds
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "growth_policy.hpp"
+
+namespace ds {
+  // owns the nodes of a node based container. Nodes live in chunks which are
+  // never moved, so node addresses ( and iterators ) stay valid while the pool
+  // grows. Destroyed nodes are kept in an intrusive free list for reuse, new
+  // chunks are sized by the growth policy.
+  template < typename Node, growth_policy Growth = growth::geometric<>,
+             typename Alloc = std::allocator< Node > >
+  class node_pool {
+  public:
+    using node_type = Node;
+    using growth    = Growth;
+
+    // smallest chunk the pool allocates, so small containers don't start with
+    // a chunk per node
+    static constexpr size_t min_chunk = 16;
+
+  private:
+    union slot {
+      slot* next_free;
+      node_type node;
+
+      slot() : next_free( nullptr ) { }
+      ~slot() { }
+    };
+
+    using allocator_type = typename std::allocator_traits< Alloc >::template rebind_alloc< slot >;
+    using alloc_traits   = std::allocator_traits< allocator_type >;
+
+    struct chunk {
+      slot* slots;
+      size_t count;
+    };
+
+    [[no_unique_address]] allocator_type alloc{};
+    std::vector< chunk > chunks;
+    size_t Capacity = 0;
+
+    slot* free_list = nullptr;
+    slot* bump      = nullptr; // unused tail of the newest chunk
+    slot* bump_end  = nullptr;
+
+    void add_chunk( size_t count ) {
+      slot* slots = alloc_traits::allocate( alloc, count );
+
+      // the unused tail of the previous chunk stays reachable through the free list
+      while ( bump != bump_end ) {
+        bump->next_free = free_list;
+        free_list       = bump++;
+      }
+
+      chunks.push_back( { slots, count } );
+
+      Capacity += count;
+      bump     = slots;
+      bump_end = slots + count;
+    }
+
+    slot* take_slot() {
+      if ( free_list != nullptr )
+        return std::exchange( free_list, free_list->next_free );
+
+      if ( bump == bump_end ) {
+        const auto grown = Growth::next_capacity( Capacity, Capacity + 1 ) - Capacity;
+        add_chunk( std::max( grown, min_chunk ) );
+      }
+
+      return bump++;
+    }
+
+  public:
+    node_pool() = default;
+
+    explicit node_pool( const Alloc& a ) : alloc( a ) { }
+
+    node_pool( node_pool&& other ) noexcept :
+        alloc( other.alloc ), chunks( std::move( other.chunks ) ),
+        Capacity( std::exchange( other.Capacity, 0 ) ),
+        free_list( std::exchange( other.free_list, nullptr ) ),
+        bump( std::exchange( other.bump, nullptr ) ),
+        bump_end( std::exchange( other.bump_end, nullptr ) ) {
+      other.chunks.clear();
+    }
+
+    node_pool& operator=( node_pool&& other ) noexcept {
+      std::swap( alloc, other.alloc );
+      std::swap( chunks, other.chunks );
+      std::swap( Capacity, other.Capacity );
+      std::swap( free_list, other.free_list );
+      std::swap( bump, other.bump );
+      std::swap( bump_end, other.bump_end );
+      return *this;
+    }
+
+    node_pool( const node_pool& ) = delete;
+    node_pool& operator=( const node_pool& ) = delete;
+
+    // frees the memory only, live nodes have to be destroyed by the owner
+    ~node_pool() { release(); }
+
+    template < typename... Args >
+    node_type* create( Args&&... args ) {
+      slot* s = take_slot();
+
+      try {
+        return std::construct_at( std::addressof( s->node ), std::forward< Args >( args )... );
+      } catch ( ... ) {
+        s->next_free = free_list;
+        free_list    = s;
+        throw;
+      }
+    }
+
+    void destroy( node_type* node ) noexcept {
+      std::destroy_at( node );
+
+      // the node is the first member of its slot
+      auto s       = reinterpret_cast< slot* >( node );
+      s->next_free = free_list;
+      free_list    = s;
+    }
+
+    // makes sure 'count' nodes can be created without allocating again,
+    // the missing nodes are allocated as one chunk
+    void reserve( size_t count ) {
+      const auto available = Capacity - size_used();
+
+      if ( count > available )
+        add_chunk( count - available );
+    }
+
+    // frees every chunk at once. Live nodes are not destroyed, so this is only
+    // correct for trivially destructible nodes or after destroying them.
+    void release() noexcept {
+      for ( auto& c : chunks )
+        alloc_traits::deallocate( alloc, c.slots, c.count );
+
+      chunks.clear();
+      Capacity  = 0;
+      free_list = nullptr;
+      bump = bump_end = nullptr;
+    }
+
+    size_t capacity() const noexcept { return Capacity; }
+
+  private:
+    // nodes handed out and not destroyed
+    size_t size_used() const noexcept {
+      size_t free_count = static_cast< size_t >( bump_end - bump );
+      for ( slot* s = free_list; s != nullptr; s = s->next_free )
+        ++free_count;
+
+      return Capacity - free_count;
+    }
+  };
+} // namespace ds
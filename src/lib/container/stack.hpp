@@ -1,15 +1,22 @@
 #pragma once
 
+#include <iterator>
+#include <type_traits>
+
 #include "data_manager.hpp"
 
 namespace ds {
   template < typename T, typename Manager = data_manager< T > >
   class stack {
   public:
-    using value_type = typename Manager::value_type;
+    using value_type     = typename Manager::value_type;
+    using allocator_type = typename Manager::allocator_type;
 
     using iterator = typename Manager::reverse_iterator;
 
+    using segments_type       = typename Manager::segments_type;
+    using const_segments_type = typename Manager::const_segments_type;
+
   private:
     size_t num_elements = 0;
     Manager data;
@@ -17,9 +24,11 @@ namespace ds {
   public:
     stack() = default;
 
-    stack( const value_type& t ) noexcept { data[num_elements++] = t; }
+    explicit stack( const allocator_type& alloc ) : data( alloc ) { }
+
+    stack( const value_type& t ) { data.emplace( num_elements++, t ); }
 
-    stack( value_type&& val ) noexcept { data[num_elements++] = std::move( val ); }
+    stack( value_type&& val ) { data.emplace( num_elements++, std::move( val ) ); }
 
     stack( const stack& st ) : data( st.data ), num_elements( st.num_elements ) { }
 
@@ -41,18 +50,73 @@ namespace ds {
       return *this;
     }
 
-    void push( const value_type& t ) {
+    void push( const value_type& t ) { emplace( t ); }
+
+    void push( value_type&& t ) { emplace( std::move( t ) ); }
+
+    // constructs the new top element inside the block storage
+    template < typename... Args >
+    value_type& emplace( Args&&... args ) {
       if ( data.size() == num_elements )
         data.expand_by( 1 );
 
-      data[num_elements++] = t;
+      auto& val = data.emplace( num_elements, std::forward< Args >( args )... );
+      ++num_elements;
+      return val;
     }
 
-    void push( value_type&& t ) {
-      if ( data.size() == num_elements )
-        data.expand_by( 1 );
+    // makes room for 'count' elements, later pushes up to that size do not allocate
+    void reserve( size_t count ) { data.expand_to( count ); }
 
-      data[num_elements++] = std::move( t );
+    // pushes 'count' values starting at 'first', block by block. The last value
+    // ends up on top. Returns the iterator past the last value read.
+    template < typename InputIt >
+    InputIt push_n( InputIt first, size_t count ) {
+      first = data.construct_n( num_elements, first, count );
+      num_elements += count;
+      return first;
+    }
+
+    // pushes the elements of r in iteration order
+    template < typename R >
+    void append_range( R&& r ) {
+      if constexpr ( requires { std::size( r ); } ) {
+        const auto count = static_cast< size_t >( std::size( r ) );
+
+        if constexpr ( !std::is_lvalue_reference_v< R > )
+          push_n( std::make_move_iterator( std::begin( r ) ), count );
+        else
+          push_n( std::begin( r ), count );
+      } else {
+        for ( auto&& val : r )
+          push( std::forward< decltype( val ) >( val ) );
+      }
+    }
+
+    // replaces the content with the values of [first, last), the last one on top
+    template < typename InputIt >
+    void assign( InputIt first, InputIt last ) {
+      using category = typename std::iterator_traits< InputIt >::iterator_category;
+
+      data.destroy_n( 0, num_elements );
+      num_elements = 0;
+
+      if constexpr ( std::is_base_of_v< std::forward_iterator_tag, category > ) {
+        push_n( first, static_cast< size_t >( std::distance( first, last ) ) );
+      } else {
+        for ( ; first != last; ++first )
+          push( *first );
+      }
+    }
+
+    // pops elements or pushes copies of 'val' until the stack holds 'count' elements
+    void resize( size_t count, const value_type& val = value_type() ) {
+      if ( count < num_elements )
+        data.destroy_n( count, num_elements );
+      else if ( count > num_elements )
+        data.fill_n( num_elements, count - num_elements, val );
+
+      num_elements = count;
     }
 
     value_type& top() noexcept { return data[num_elements - 1]; }
@@ -61,13 +125,18 @@ namespace ds {
 
     void pop() noexcept {
       if ( num_elements != 0 )
-        data[--num_elements] = value_type();
+        data.destroy( --num_elements );
     }
 
     size_t size() const noexcept { return num_elements; }
 
     bool is_empty() const noexcept { return num_elements == 0; }
 
+    // the elements as contiguous spans from bottom to top ( see algorithms.hpp )
+    segments_type segments() noexcept { return data.segments( 0, num_elements ); }
+
+    const_segments_type segments() const noexcept { return data.segments( 0, num_elements ); }
+
     iterator end() const noexcept { return data.rend(); }
 
     iterator begin() const noexcept { return data.rbegin() + ( data.size() - num_elements ); }
@@ -76,4 +145,8 @@ namespace ds {
 
     iterator begin() noexcept { return data.rbegin() + ( data.size() - num_elements ); }
   };
+
+  // stack allocating its blocks through Alloc ( e.g. ds::pool_allocator< T > )
+  template < typename T, typename Alloc >
+  using alloc_stack = stack< T, data_manager< T, void, growth::geometric<>, Alloc > >;
 } // namespace ds
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <iterator>
 #include <ostream>
+#include <type_traits>
 
 #include "data_manager.hpp"
 
@@ -8,145 +10,236 @@ namespace ds {
   template < typename T, typename Manager = data_manager< T > >
   class vector {
   public:
-    using value_type = typename Manager::value_type;
+    using value_type     = typename Manager::value_type;
+    using allocator_type = typename Manager::allocator_type;
 
     using iterator         = typename Manager::iterator;
     using reverse_iterator = typename Manager::reverse_iterator;
 
+    using segments_type       = typename Manager::segments_type;
+    using const_segments_type = typename Manager::const_segments_type;
+
   private:
+    // the elements occupy the slots [head, tail) of data, the slots in front
+    // of head make push_front O(1)
     Manager data;
-    iterator last = data.begin();
+    size_t head = 0, tail = 0;
 
   public:
     vector() = default;
 
-    vector( const value_type& val ) : data() {
-      data[0] = val;
-      ++last;
-    }
+    explicit vector( const allocator_type& alloc ) : data( alloc ) { }
 
-    vector( value_type&& val ) : data() {
-      data[0] = std::move( val );
-      ++last;
-    }
+    vector( const value_type& val ) { push_back( val ); }
 
-    void push_back( const value_type& val ) {
-      if ( last == data.end() ) {
-        data.expand_by( 1 );
-      }
+    vector( value_type&& val ) { push_back( std::move( val ) ); }
 
-      *( last++ ) = val;
-    }
+    void push_back( const value_type& val ) { emplace_back( val ); }
 
-    void push_back( value_type&& val ) {
-      if ( last == data.end() ) {
-        data.expand_by( 1 );
-      }
+    void push_back( value_type&& val ) { emplace_back( std::move( val ) ); }
 
-      *( last++ ) = std::move( val );
-    }
+    void push_front( const value_type& val ) { emplace_front( val ); }
 
-    void push_front( const value_type& val ) {
-      if ( last == data.end() ) {
+    void push_front( value_type&& val ) { emplace_front( std::move( val ) ); }
+
+    // the emplace functions construct the element inside the block storage
+    template < typename... Args >
+    value_type& emplace_back( Args&&... args ) {
+      if ( tail == data.size() )
         data.expand_by( 1 );
-      }
 
-      shift_at( 0 );
-      data[0] = val;
-      ++last;
+      auto& val = data.emplace( tail, std::forward< Args >( args )... );
+      ++tail;
+      return val;
     }
 
-    void push_front( value_type&& val ) {
-      if ( last == data.end() ) {
-        data.expand_by( 1 );
-      }
+    template < typename... Args >
+    value_type& emplace_front( Args&&... args ) {
+      if ( head == 0 )
+        grow_front();
 
-      shift_at( 0 );
-      data[0] = std::move( val );
-      ++last;
+      auto& val = data.emplace( head - 1, std::forward< Args >( args )... );
+      --head;
+      return val;
     }
 
-    void insert( const value_type& val, size_t index = 0 ) {
-      if ( last == data.end() ) {
-        data.expand_by( 1 );
-      }
+    template < typename... Args >
+    value_type& emplace( size_t index, Args&&... args ) {
+      if ( index == 0 )
+        return emplace_front( std::forward< Args >( args )... );
+
+      if ( index >= size() )
+        return emplace_back( std::forward< Args >( args )... );
 
-      shift_at( index );
-      data[index] = val;
-      ++last;
+      // the value is built before anything moves, the arguments may refer to
+      // an element of this vector. The gap holds a moved-from value.
+      value_type val( std::forward< Args >( args )... );
+      return reconstruct( data[open_gap( index )], std::move( val ) );
     }
 
-    void insert( value_type&& val, size_t index = 0 ) {
-      if ( last == data.end() ) {
-        data.expand_by( 1 );
-      }
+    // makes room for 'count' elements, later pushes up to that size do not allocate
+    void reserve( size_t count ) { data.expand_to( head + count ); }
 
-      shift_at( index );
-      data[index] = std::move( val );
-      ++last;
+    // copies 'count' values starting at 'first' to the back, block by block.
+    // Returns the iterator past the last value read.
+    template < typename InputIt >
+    InputIt push_n( InputIt first, size_t count ) {
+      first = data.construct_n( tail, first, count );
+      tail += count;
+      return first;
     }
 
-    void shift_at( size_t index, long long amount = 1 ) {
-      using diff_type = typename iterator::difference_type;
+    // appends the elements of r, sized ranges need only one allocation step
+    template < typename R >
+    void append_range( R&& r ) {
+      constexpr bool movable = !std::is_lvalue_reference_v< R >;
 
-      if ( data[0] != value_type() && amount != 0 ) {
-        if ( amount > 0 ) {
-          for ( diff_type i = last - begin(); i > static_cast< diff_type >( index ); i-- )
-            data[static_cast< size_t >( i + amount )] =
-              std::move( data[static_cast< size_t >( i )] );
+      if constexpr ( std::is_same_v< std::remove_cvref_t< R >, vector > ) {
+        reserve( size() + r.size() );
 
-          data[index + static_cast< size_t >( amount )] = std::move( data[index] );
-        } else {
-          for ( diff_type i = static_cast< diff_type >( index ); i < last - begin(); i++ )
-            data[static_cast< size_t >( i )] =
-              std::move( data[static_cast< size_t >( i - amount )] );
+        for ( auto segment : r.segments() ) {
+          if constexpr ( movable )
+            push_n( std::make_move_iterator( segment.begin() ), segment.size() );
+          else
+            push_n( segment.begin(), segment.size() );
         }
+      } else if constexpr ( requires { std::size( r ); } ) {
+        const auto count = static_cast< size_t >( std::size( r ) );
+
+        if constexpr ( movable )
+          push_n( std::make_move_iterator( std::begin( r ) ), count );
+        else
+          push_n( std::begin( r ), count );
+      } else {
+        for ( auto&& val : r )
+          push_back( std::forward< decltype( val ) >( val ) );
       }
     }
 
-    value_type& operator[]( size_t index ) { return data[index]; }
+    // replaces the content with the values of [first, last)
+    template < typename InputIt >
+    void assign( InputIt first, InputIt last ) {
+      using category = typename std::iterator_traits< InputIt >::iterator_category;
+
+      clear();
+
+      if constexpr ( std::is_base_of_v< std::forward_iterator_tag, category > ) {
+        push_n( first, static_cast< size_t >( std::distance( first, last ) ) );
+      } else {
+        for ( ; first != last; ++first )
+          push_back( *first );
+      }
+    }
 
-    const value_type& operator[]( size_t index ) const { return data[index]; }
+    // shrinks by destroying elements at the back or grows by appending copies of 'val'
+    void resize( size_t count, const value_type& val = value_type() ) {
+      if ( count < size() )
+        data.destroy_n( head + count, tail );
+      else if ( count > size() )
+        data.fill_n( tail, count - size(), val );
 
+      tail = head + count;
+    }
+
+    void insert( const value_type& val, size_t index = 0 ) { emplace( index, val ); }
+
+    void insert( value_type&& val, size_t index = 0 ) { emplace( index, std::move( val ) ); }
+
+    value_type& operator[]( size_t index ) { return data[head + index]; }
+
+    const value_type& operator[]( size_t index ) const { return data[head + index]; }
+
+    // moves the shorter side of the vector over the erased element
     void erase_at( size_t index ) {
-      shift_at( index, -1 );
-      --last;
+      if ( index < size() / 2 ) {
+        data.move_back( head, head + index );
+        data.destroy( head++ );
+      } else {
+        data.move_front( head + index + 1, tail );
+        data.destroy( --tail );
+      }
     }
 
     void erase( const value_type& val ) {
-      using diff_type = typename iterator::difference_type;
-
-      for ( size_t i = 0; static_cast< diff_type >( i ) <= last - begin(); i++ ) {
-        if ( data[i] == val ) {
-          shift_at( i, -1 );
-          --last;
+      for ( size_t i = 0; i < size(); i++ ) {
+        if ( ( *this )[i] == val ) {
+          erase_at( i );
           break;
         }
       }
     }
 
-    void clear() noexcept { last = data.begin(); }
+    void clear() noexcept {
+      data.clear();
+      head = tail = 0;
+    }
 
-    size_t size() const noexcept { return static_cast< size_t >( last - begin() ); }
+    size_t size() const noexcept { return tail - head; }
 
-    constexpr iterator begin() noexcept { return data.begin(); }
+    // the elements as contiguous spans ( see algorithms.hpp )
+    segments_type segments() noexcept { return data.segments( head, tail ); }
 
-    constexpr iterator begin() const noexcept { return data.begin(); }
+    const_segments_type segments() const noexcept { return data.segments( head, tail ); }
 
-    constexpr reverse_iterator rend() noexcept { return data.rend(); }
+    constexpr iterator begin() noexcept { return data.iterator_at( head ); }
 
-    constexpr reverse_iterator rend() const noexcept { return data.rend(); }
+    constexpr iterator begin() const noexcept { return data.iterator_at( head ); }
 
-    constexpr iterator end() noexcept { return last; }
+    constexpr reverse_iterator rend() noexcept {
+      return static_cast< reverse_iterator >( begin() );
+    }
 
-    constexpr iterator end() const noexcept { return last; }
+    constexpr reverse_iterator rend() const noexcept {
+      return static_cast< reverse_iterator >( begin() );
+    }
+
+    constexpr iterator end() noexcept { return data.iterator_at( tail ); }
+
+    constexpr iterator end() const noexcept { return data.iterator_at( tail ); }
 
     constexpr reverse_iterator rbegin() noexcept {
-      return static_cast< reverse_iterator >( last - 1 );
+      return static_cast< reverse_iterator >( end() );
     }
 
     constexpr reverse_iterator rbegin() const noexcept {
-      return static_cast< reverse_iterator >( last - 1 );
+      return static_cast< reverse_iterator >( end() );
+    }
+
+  private:
+    // adds a block in front, the block table itself grows geometrically
+    void grow_front() {
+      const auto old_size = data.size();
+      data.expand_front_by( 1 );
+
+      const auto shift = data.size() - old_size;
+      head += shift;
+      tail += shift;
+    }
+
+    // makes room for a new element at 'index' ( 0 < index < size() ) by moving
+    // the shorter side, returns the slot which holds a moved-from value now
+    size_t open_gap( size_t index ) {
+      if ( index < size() / 2 ) {
+        if ( head == 0 )
+          grow_front();
+
+        data.emplace( head - 1, std::move( data[head] ) );
+        data.move_front( head + 1, head + index );
+        --head;
+      } else {
+        if ( tail == data.size() )
+          data.expand_by( 1 );
+
+        data.emplace( tail, std::move( data[tail - 1] ) );
+        data.move_back( head + index, tail - 1 );
+        ++tail;
+      }
+
+      return head + index;
     }
   };
+
+  // vector allocating its blocks through Alloc ( e.g. ds::pool_allocator< T > )
+  template < typename T, typename Alloc >
+  using alloc_vector = vector< T, data_manager< T, void, growth::geometric<>, Alloc > >;
 } // namespace ds
@@ -1,32 +1,495 @@
-
 #pragma once
 
-#include <array>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <compare>
 #include <concepts>
+#include <cstdint>
+#include <limits>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <utility>
-#include <vector>
 
-template < size_t Base = 10, size_t Presision = 16 >
-class floatingpoint {
-  bool is_negativ = false;
-  std::array< size_t, Presision > digits; // significant digits
-  std::wstring symbols = L"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+#include "integer.hpp"
+#include "modular.hpp"
+
+namespace ds {
+  // binary floating point number of arbitrary precision, the value is
+  // ( -1 )^sign * mantissa * 2^exponent with a mantissa of exactly 'precision'
+  // bits. 'Presision' is the number of digits in base 'Base' it keeps, 'Base'
+  // is also the radix used for parsing and printing. Every operation rounds
+  // its exact result to the nearest number, ties to an even mantissa.
+  template < size_t Base = 10, size_t Presision = 16 >
+  class floatingpoint {
+    static_assert( Presision > 0, "a floatingpoint needs at least one digit" );
+
+    template < size_t B, size_t P >
+    friend class floatingpoint;
+
+  public:
+    // bits of the mantissa, enough for Base^Presision different values
+    static constexpr size_t precision = [] {
+      integer< Base > power = 1;
+      for ( size_t i = 0; i < Presision; ++i )
+        power *= Base;
+      return std::max< size_t >( power.bit_width(), 2 );
+    }();
+
+  private:
+    bool is_negativ = false;
+    integer< Base > mantissa;  // 'precision' bits, 0 for 0
+    std::int64_t exponent = 0; // 0 for 0
+
+    static constexpr bool bit( const integer< Base >& m, size_t index ) noexcept {
+      const auto mag = m.magnitude();
+      const size_t i = index / limbs::limb_bits;
+      return i < mag.size() && ( ( mag[i] >> ( index % limbs::limb_bits ) ) & 1 ) != 0;
+    }
+
+    // true if any of the lowest 'count' bits is set
+    static constexpr bool any_bit_below( const integer< Base >& m, size_t count ) noexcept {
+      const auto mag = m.magnitude();
+      for ( size_t i = 0; i < mag.size() && i * limbs::limb_bits < count; ++i ) {
+        const size_t bits = std::min< size_t >( count - i * limbs::limb_bits, limbs::limb_bits );
+        const auto mask   = bits == limbs::limb_bits ? ~limbs::limb( 0 )
+                                                     : ( limbs::limb( 1 ) << bits ) - 1;
+        if ( ( mag[i] & mask ) != 0 )
+          return true;
+      }
+      return false;
+    }
+
+    // m / 2^drop for m >= 0 and drop > 0, rounded to nearest with ties to
+    // even. 'sticky' tells that nonzero bits below m were cut off already.
+    static constexpr integer< Base > shift_rounded( integer< Base > m, size_t drop,
+                                                    bool sticky ) {
+      const bool half  = bit( m, drop - 1 );
+      const bool below = sticky || any_bit_below( m, drop - 1 );
+
+      m >>= drop;
+      if ( half && ( below || bit( m, 0 ) ) )
+        m += 1;
+      return m;
+    }
+
+    // *this = m * 2^e rounded to 'precision' bits for m >= 0. 'sticky' tells
+    // that nonzero bits below m were cut off already, then m has at least
+    // precision + 1 bits.
+    constexpr void assign_rounded( bool negativ, integer< Base > m, std::int64_t e,
+                                   bool sticky ) {
+      const size_t bits = m.bit_width();
+      if ( bits == 0 ) {
+        *this = floatingpoint();
+        return;
+      }
+
+      if ( bits > precision ) {
+        const size_t drop = bits - precision;
+        m                 = shift_rounded( std::move( m ), drop, sticky );
+        e += static_cast< std::int64_t >( drop );
+
+        // the mantissa overflowed to a power of two
+        if ( m.bit_width() > precision ) {
+          m >>= 1;
+          ++e;
+        }
+      } else {
+        m <<= precision - bits;
+        e -= static_cast< std::int64_t >( precision - bits );
+      }
+
+      is_negativ = negativ;
+      mantissa   = std::move( m );
+      exponent   = e;
+    }
+
+    constexpr bool is_zero() const noexcept { return mantissa.bit_width() == 0; }
+
+    // a + b if 'b_negativ' is the sign of b, a - b if it is the opposite one
+    static constexpr floatingpoint sum( const floatingpoint& a, const floatingpoint& b,
+                                        bool b_negativ ) {
+      if ( b.is_zero() )
+        return a;
+
+      floatingpoint out;
+      if ( a.is_zero() ) {
+        out            = b;
+        out.is_negativ = b_negativ;
+        return out;
+      }
+
+      // x is the operand with the larger exponent
+      const bool swap     = a.exponent < b.exponent;
+      const auto& x       = swap ? b : a;
+      const auto& y       = swap ? a : b;
+      const bool x_neg    = swap ? b_negativ : a.is_negativ;
+      const bool y_neg    = swap ? a.is_negativ : b_negativ;
+      const auto distance = static_cast< std::uint64_t >( x.exponent - y.exponent );
+
+      integer< Base > m, tiny;
+      std::int64_t e;
+      if ( distance <= precision + 5 ) {
+        // exact
+        m    = x.mantissa << distance;
+        tiny = y.mantissa;
+        e    = y.exponent;
+      } else {
+        // y is below 2^-6 of an ulp of x, so it lies below the guard bit even
+        // after a cancellation and only acts as a sticky bit. 2^-5 of an ulp
+        // rounds the same and replaces it
+        m    = x.mantissa << 5;
+        tiny = 1;
+        e    = x.exponent - 5;
+      }
+
+      if ( x_neg == y_neg ) {
+        out.assign_rounded( x_neg, std::move( m ) + tiny, e, false );
+      } else if ( m >= tiny ) {
+        out.assign_rounded( x_neg, std::move( m ) - tiny, e, false );
+      } else {
+        out.assign_rounded( y_neg, std::move( tiny ) - m, e, false );
+      }
+      return out;
+    }
+
+    // round( num / den ) with ties to even, for num, den > 0
+    static constexpr integer< Base > divide_rounded( const integer< Base >& num,
+                                                     const integer< Base >& den ) {
+      auto [q, r]      = divmod( num, den );
+      const auto order = r * 2 <=> den;
+      if ( order > 0 || ( order == 0 && bit( q, 0 ) ) )
+        q += 1;
+      return std::move( q );
+    }
+
+    // round( |*this| * Base^k ) with ties to even
+    constexpr integer< Base > scaled( std::int64_t k ) const {
+      integer< Base > num = mantissa, den = 1;
+      const auto power = pow( integer< Base >( Base ), static_cast< size_t >( k < 0 ? -k : k ) );
+
+      if ( k >= 0 )
+        num *= power;
+      else
+        den = power;
+
+      if ( exponent >= 0 )
+        num <<= static_cast< size_t >( exponent );
+      else
+        den <<= static_cast< size_t >( -exponent );
+
+      return divide_rounded( num, den );
+    }
+
+    template < typename Char >
+    constexpr void parse( std::basic_string_view< Char > str ) {
+      // the exponent is written in decimal after an 'e', or '@' for bases in
+      // which 'e' is a digit
+      const auto is_exponent_mark = []( Char c ) {
+        return c == Char( '@' ) || ( Base <= 10 && ( c == Char( 'e' ) || c == Char( 'E' ) ) );
+      };
+
+      bool negativ = false;
+      if ( !str.empty() && ( str[0] == Char( '-' ) || str[0] == Char( '+' ) ) ) {
+        negativ = str[0] == Char( '-' );
+        str.remove_prefix( 1 );
+      }
+
+      std::basic_string< Char > digits;
+      std::int64_t shift = 0; // the value is digits * Base^shift
+      bool fraction      = false;
+      size_t i           = 0;
+      for ( ; i < str.size() && !is_exponent_mark( str[i] ); ++i ) {
+        if ( str[i] == Char( '.' ) ) {
+          assert( !fraction && "a number with two points" );
+          fraction = true;
+        } else {
+          digits.push_back( str[i] );
+          shift -= fraction ? 1 : 0;
+        }
+      }
+
+      if ( i < str.size() ) {
+        bool exponent_negativ = false;
+        std::int64_t e        = 0;
+        ++i;
+        if ( i < str.size() && ( str[i] == Char( '-' ) || str[i] == Char( '+' ) ) ) {
+          exponent_negativ = str[i] == Char( '-' );
+          ++i;
+        }
+        assert( i < str.size() && "an exponent without digits" );
+        // the bound also keeps shift, which counts the fraction digits, in range
+        constexpr std::int64_t max_exponent = std::numeric_limits< std::int64_t >::max() / 4;
+        for ( ; i < str.size(); ++i ) {
+          assert( str[i] >= Char( '0' ) && str[i] <= Char( '9' ) && "not a decimal exponent" );
+          assert( e <= ( max_exponent - 9 ) / 10 && "the exponent is too large" );
+          e = e * 10 + ( str[i] - Char( '0' ) );
+        }
+        shift += exponent_negativ ? -e : e;
+      }
+
+      const integer< Base > value{ std::basic_string_view< Char >( digits ) };
+      if ( value == 0 ) {
+        *this = floatingpoint();
+      } else if ( shift >= 0 ) {
+        const auto power = pow( integer< Base >( Base ), static_cast< size_t >( shift ) );
+        assign_rounded( negativ, value * power, 0, false );
+      } else {
+        // enough quotient bits to round, the remainder only decides ties
+        const auto den    = pow( integer< Base >( Base ), static_cast< size_t >( -shift ) );
+        const auto wanted = precision + 2 + den.bit_width();
+        const auto s      = wanted - std::min( value.bit_width(), wanted );
+        const auto [q, r] = divmod( value << s, den );
+        assign_rounded( negativ, q, -static_cast< std::int64_t >( s ), r != 0 );
+      }
+    }
+
+    // 'Presision' significant digits, positional for moderate exponents and
+    // scientific otherwise
+    template < typename Char >
+    std::basic_string< Char > format() const {
+      std::basic_string< Char > out;
+      if ( is_zero() ) {
+        out.push_back( Char( '0' ) );
+        return out;
+      }
+      if ( is_negativ )
+        out.push_back( Char( '-' ) );
+
+      const auto digits = static_cast< std::int64_t >( Presision );
+      const auto lowest = pow( integer< Base >( Base ), Presision - 1 );
+      const auto limit  = lowest * Base;
+
+      // x = floor( log_Base |*this| ), estimated from the bits and corrected
+      auto x = static_cast< std::int64_t >(
+        std::floor( static_cast< double >( static_cast< std::int64_t >( precision ) - 1 +
+                                           exponent ) *
+                    std::log( 2.0 ) / std::log( static_cast< double >( Base ) ) ) );
+      integer< Base > n;
+      while ( true ) {
+        n = scaled( digits - 1 - x );
+        if ( n >= limit )
+          ++x;
+        else if ( n < lowest )
+          --x;
+        else
+          break;
+      }
+
+      auto text = static_cast< std::basic_string< Char > >( n );
+      while ( text.size() > 1 && text.back() == Char( '0' ) )
+        text.pop_back();
+
+      const auto size = static_cast< std::int64_t >( text.size() );
+      if ( x >= digits || x < -5 ) {
+        out.push_back( text[0] );
+        if ( size > 1 ) {
+          out.push_back( Char( '.' ) );
+          out.append( text, 1 );
+        }
+        out.push_back( Base <= 10 ? Char( 'e' ) : Char( '@' ) );
+        for ( char c : std::to_string( x ) )
+          out.push_back( Char( c ) );
+      } else if ( x >= 0 ) {
+        out.append( text, 0, static_cast< size_t >( std::min( size, x + 1 ) ) );
+        for ( auto i = size; i < x + 1; ++i )
+          out.push_back( Char( '0' ) );
+        if ( size > x + 1 ) {
+          out.push_back( Char( '.' ) );
+          out.append( text, static_cast< size_t >( x + 1 ) );
+        }
+      } else {
+        out.push_back( Char( '0' ) );
+        out.push_back( Char( '.' ) );
+        out.append( static_cast< size_t >( -x - 1 ), Char( '0' ) );
+        out.append( text );
+      }
+      return out;
+    }
+
+  public:
+    constexpr floatingpoint() = default;
+
+    constexpr floatingpoint( const floatingpoint& other ) = default;
+
+    constexpr floatingpoint( floatingpoint&& other ) noexcept = default;
+
+    template < std::integral I >
+    constexpr floatingpoint( I value ) : floatingpoint( integer< Base >( value ) ) { }
+
+    // rounded if the precision is below the 53 bits of a double. The value
+    // has to be finite.
+    constexpr floatingpoint( double value ) {
+      const auto bits          = std::bit_cast< std::uint64_t >( value );
+      const auto biased        = static_cast< std::int64_t >( ( bits >> 52 ) & 0x7FF );
+      const std::uint64_t frac = bits & ( ( std::uint64_t( 1 ) << 52 ) - 1 );
+      assert( biased != 0x7FF && "infinity or NaN" );
+
+      // subnormal numbers have no hidden bit
+      const auto m = biased == 0 ? frac : frac | ( std::uint64_t( 1 ) << 52 );
+      const auto e = biased == 0 ? -1074 : biased - 1075;
+      assign_rounded( ( bits >> 63 ) != 0, integer< Base >( m ), e, false );
+    }
+
+    template < size_t B >
+    constexpr explicit floatingpoint( const integer< B >& value ) {
+      integer< Base > m  = value;
+      const bool negativ = m.negativ();
+      assign_rounded( negativ, negativ ? -m : m, 0, false );
+    }
+
+    // rounds to this precision
+    template < size_t B, size_t P >
+    constexpr explicit floatingpoint( const floatingpoint< B, P >& other ) {
+      assign_rounded( other.is_negativ, other.mantissa, other.exponent, false );
+    }
+
+    // like "-12.5e-3", in base 'Base'
+    constexpr floatingpoint( std::string_view str ) { parse( str ); }
+
+    constexpr floatingpoint( std::wstring_view str ) { parse( str ); }
+
+    constexpr floatingpoint& operator=( const floatingpoint& other ) = default;
+
+    constexpr floatingpoint& operator=( floatingpoint&& other ) noexcept = default;
+
+    template < std::integral I >
+    constexpr floatingpoint& operator=( I value ) {
+      return *this = floatingpoint( value );
+    }
+
+    // rounds toward zero, like the built in conversion
+    template < size_t B >
+    constexpr explicit operator integer< B >() const {
+      integer< B > out = exponent >= 0 ? mantissa << static_cast< size_t >( exponent )
+                                       : mantissa >> static_cast< size_t >( -exponent );
+      return is_negativ ? -out : out;
+    }
+
+    // rounded once, to the 53 bits of a double or to the fixed ulp of 2^-1074
+    // of the subnormal doubles
+    explicit operator double() const {
+      if ( is_zero() )
+        return 0.0;
+
+      const auto top    = exponent + static_cast< std::int64_t >( precision ) - 1;
+      const auto lowest = std::max< std::int64_t >( top - 52, -1074 );
+
+      // the value is mantissa * 2^exponent = m * 2^e with m at most 2^53
+      auto m = mantissa;
+      auto e = exponent;
+      if ( lowest > e ) {
+        m = shift_rounded( std::move( m ), static_cast< size_t >( lowest - e ), false );
+        e = lowest;
+      }
+
+      const auto value = std::ldexp( static_cast< double >( static_cast< std::uint64_t >( m ) ),
+                                     static_cast< int >( std::clamp< std::int64_t >(
+                                       e, -100'000, 100'000 ) ) );
+      return is_negativ ? -value : value;
+    }
+
+    explicit operator std::string() const { return format< char >(); }
+
+    explicit operator std::wstring() const { return format< wchar_t >(); }
+
+    constexpr bool negativ() const noexcept { return is_negativ; }
+
+    constexpr bool operator==( const floatingpoint& other ) const noexcept = default;
+
+    constexpr std::strong_ordering operator<=>( const floatingpoint& other ) const noexcept {
+      if ( is_negativ != other.is_negativ )
+        return is_negativ ? std::strong_ordering::less : std::strong_ordering::greater;
+
+      // mantissas of the same length compare by the exponent first
+      std::strong_ordering order = std::strong_ordering::equal;
+      if ( is_zero() || other.is_zero() )
+        order = other.is_zero() <=> is_zero();
+      else if ( exponent != other.exponent )
+        order = exponent <=> other.exponent;
+      else
+        order = mantissa <=> other.mantissa;
+
+      return is_negativ ? 0 <=> order : order;
+    }
+
+    constexpr floatingpoint operator-() const {
+      floatingpoint out = *this;
+      out.is_negativ    = !is_zero() && !is_negativ;
+      return out;
+    }
+
+    constexpr floatingpoint& operator+=( const floatingpoint& n ) {
+      return *this = sum( *this, n, n.is_negativ );
+    }
+
+    constexpr floatingpoint& operator-=( const floatingpoint& n ) {
+      return *this = sum( *this, n, !n.is_negativ );
+    }
+
+    constexpr floatingpoint& operator*=( const floatingpoint& n ) { return *this = *this * n; }
+
+    constexpr floatingpoint& operator/=( const floatingpoint& n ) { return *this = *this / n; }
+
+    friend constexpr floatingpoint operator+( const floatingpoint& a, const floatingpoint& b ) {
+      return sum( a, b, b.is_negativ );
+    }
+
+    friend constexpr floatingpoint operator-( const floatingpoint& a, const floatingpoint& b ) {
+      return sum( a, b, !b.is_negativ );
+    }
+
+    friend constexpr floatingpoint operator*( const floatingpoint& a, const floatingpoint& b ) {
+      floatingpoint out;
+      out.assign_rounded( a.is_negativ != b.is_negativ, a.mantissa * b.mantissa,
+                          a.exponent + b.exponent, false );
+      return out;
+    }
+
+    // the quotient gets two bits more than needed, the remainder decides ties
+    friend constexpr floatingpoint operator/( const floatingpoint& a, const floatingpoint& b ) {
+      assert( !b.is_zero() && "division by zero" );
+
+      constexpr size_t extra = precision + 2;
+      const auto [q, r]      = divmod( a.mantissa << extra, b.mantissa );
+
+      floatingpoint out;
+      out.assign_rounded( a.is_negativ != b.is_negativ, q,
+                          a.exponent - b.exponent - static_cast< std::int64_t >( extra ),
+                          r != 0 );
+      return out;
+    }
+
+    // the root of a mantissa shifted to at least 2 * precision + 4 bits has
+    // precision + 2 bits, the remainder decides ties
+    friend constexpr floatingpoint sqrt( const floatingpoint& a ) {
+      assert( !a.is_negativ && "square root of a negative number" );
+      if ( a.is_zero() )
+        return a;
+
+      auto shift = static_cast< std::int64_t >( precision + 4 );
+      if ( ( a.exponent - shift ) % 2 != 0 )
+        ++shift;
 
-  static void distribute( floatingpoint& f ) { }
+      const auto n    = a.mantissa << static_cast< size_t >( shift );
+      const auto root = isqrt( n );
 
-public:
-  floatingpoint() = default;
-  floatingpoint( const floatingpoint& other );
-  floatingpoint( floatingpoint&& other );
+      floatingpoint out;
+      out.assign_rounded( false, root, ( a.exponent - shift ) / 2, root * root != n );
+      return out;
+    }
+  };
 
-  template < std::integral I >
-  floatingpoint( I value );
+  using Float = floatingpoint<>;
 
-  floatingpoint& operator=( const floatingpoint& other );
-  floatingpoint& operator=( floatingpoint&& other );
+  template < size_t Base, size_t Presision, typename T >
+  std::basic_ostream< T >& operator<<( std::basic_ostream< T >& str,
+                                       const floatingpoint< Base, Presision >& n ) {
+    using size_type = std::streamsize;
+    auto s          = static_cast< std::basic_string< T > >( n );
+    return str.write( s.c_str(), static_cast< size_type >( s.size() ) );
+  }
 
-  template < std::integral I >
-  floatingpoint& operator=( I value );
-};
+} // namespace ds
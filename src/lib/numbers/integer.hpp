@@ -1,354 +1,646 @@
 #pragma once
 
 #include <algorithm>
-#include <math.h>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <limits>
+#include <mutex>
 #include <ostream>
+#include <set>
+#include <span>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "limb_vector.hpp"
+#include "limbs.hpp"
+
 namespace ds {
+  namespace detail {
+    inline constexpr std::wstring_view default_symbols = L"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    // every custom set of symbols is stored once for the whole program, so an
+    // integer only keeps a view of it. Sets are never removed.
+    inline std::wstring_view intern_symbols( const std::wstring& s ) {
+      static std::mutex lock;
+      static std::set< std::wstring, std::less<> > table;
 
+      const std::scoped_lock guard( lock );
+      return *table.insert( s ).first;
+    }
+  } // namespace detail
+
+  // arbitrary precision integer. The magnitude is stored in 64 bit limbs
+  // ( base 2^64 ), 'Base' is only the radix used for parsing and printing.
   template < size_t Base = 10 >
   class integer {
+    static_assert( Base >= 2, "an integer needs a base of at least 2" );
+
+    using limb = limbs::limb;
+
     bool is_negativ = false;
-    std::vector< size_t > digits;
-    std::wstring symbols = L"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    limbs::limb_vector digits; // little endian limbs without leading zeros, empty for 0
+    std::wstring_view symbols = detail::default_symbols;
+
+    // the largest power of Base that fits a limb, parsing and printing handle
+    // that many symbols per operation on the limbs
+    static constexpr size_t chunk_digits = [] {
+      size_t count = 1;
+      for ( limb power = Base; power <= std::numeric_limits< limb >::max() / Base; power *= Base )
+        ++count;
+      return count;
+    }();
+
+    static constexpr limb chunk_power = [] {
+      limb power = 1;
+      for ( size_t i = 0; i < chunk_digits; ++i )
+        power *= Base;
+      return power;
+    }();
+
+    // removes leading zero limbs, zero is never negative
+    constexpr void normalize() noexcept {
+      while ( !digits.empty() && digits.back() == 0 )
+        digits.pop_back();
+
+      if ( digits.empty() )
+        is_negativ = false;
+    }
 
-    static void distribute( integer& n ) {
-      size_t rest = 0;
+    template < std::integral I >
+    constexpr void assign( I value ) {
+      using U = std::make_unsigned_t< I >;
 
-      for ( auto&& m : n.digits ) {
-        m += rest;
-        rest = m / Base;
-        m %= Base;
+      is_negativ = value < 0;
+      // negating in the unsigned type is correct for the smallest value too
+      U magnitude = is_negativ ? U( 0 ) - static_cast< U >( value ) : static_cast< U >( value );
+
+      digits.clear();
+      if constexpr ( std::numeric_limits< U >::digits > limbs::limb_bits ) {
+        for ( ; magnitude != 0; magnitude >>= limbs::limb_bits )
+          digits.push_back( static_cast< limb >( magnitude ) );
+      } else if ( magnitude != 0 ) {
+        digits.push_back( magnitude );
       }
+    }
 
-      if ( rest > 0 ) {
-        n.digits.emplace_back( rest );
+    // *this = *this * factor + addend, for the magnitude
+    constexpr void mul_add( limb factor, limb addend ) {
+      auto data  = digits.data();
+      auto size  = digits.size();
+      limb carry = limbs::mul_1( data, data, size, factor );
+      carry += limbs::add_1( data, data, size, addend );
 
-        if ( rest >= Base )
-          distribute( n );
-      }
+      if ( carry != 0 )
+        digits.push_back( carry );
     }
 
-  public:
-    integer() = default;
+    // digits in base 'Base', the least significant first. A digit may exceed
+    // the base, it is carried into the next ones.
+    constexpr void assign_digits( const size_t* first, size_t count ) {
+      digits.clear();
+      for ( size_t i = count; i > 0; --i )
+        mul_add( Base, first[i - 1] );
+
+      is_negativ = false;
+      normalize();
+    }
+
+    // powers[i] = Base^( chunk_digits * 2^i ) for the divide and conquer radix
+    // conversion, each one the square of the one before
+    static constexpr void add_radix_powers( std::vector< integer >& powers, size_t count ) {
+      if ( powers.empty() )
+        powers.emplace_back( chunk_power );
+
+      while ( powers.size() < count )
+        powers.push_back( powers.back() * powers.back() );
+    }
 
-    integer( long long value ) {
-      if ( value < 0 ) {
-        value      = -value;
-        is_negativ = !is_negativ;
+    template < typename Char >
+    constexpr void parse( std::basic_string_view< Char > str ) {
+      assert( Base <= symbols.size() && "there is no symbol for every digit" );
+
+      bool negativ = false;
+      if ( !str.empty() && ( str[0] == Char( '-' ) || str[0] == Char( '+' ) ) ) {
+        negativ = str[0] == Char( '-' );
+        str.remove_prefix( 1 );
       }
 
-      while ( value != 0 ) {
-        digits.emplace_back( static_cast< size_t >( value ) % Base );
-        value /= Base;
+      std::vector< integer > powers;
+      if ( str.size() > limbs::radix_threshold * chunk_digits ) {
+        size_t count = 1;
+        while ( ( chunk_digits << count ) < str.size() )
+          ++count;
+        add_radix_powers( powers, count );
       }
+
+      digits     = read_digits( str, powers ).digits;
+      is_negativ = negativ;
+      normalize();
     }
 
-    template < size_t Size >
-    integer( size_t ( &value )[Size] ) {
-      digits.reserve( Size );
-      for ( int i = 0; i < Size; i++ )
-        digits[i] = value[i];
+    // the value of the symbols in 'str', the upper half times a power of the
+    // base plus the lower half
+    template < typename Char >
+    constexpr integer read_digits( std::basic_string_view< Char > str,
+                                   const std::vector< integer >& powers ) const {
+      if ( str.size() <= limbs::radix_threshold * chunk_digits )
+        return read_chunks( str );
 
-      distribute( *this );
-    }
+      size_t k = 0;
+      while ( ( chunk_digits << ( k + 1 ) ) < str.size() )
+        ++k;
+
+      const size_t low_size = chunk_digits << k;
+      const auto split      = str.size() - low_size;
 
-    integer( std::vector< size_t > v ) {
-      using namespace std;
-      copy( begin( v ), end( v ), begin( digits ) );
-      distribute( *this );
+      return read_digits( str.substr( 0, split ), powers ) * powers[k] +
+             read_digits( str.substr( split ), powers );
     }
 
-    integer( std::string_view str ) {
-      using namespace std;
-      auto set = symbols.substr( 0, Base );
+    template < typename Char >
+    constexpr integer read_chunks( std::basic_string_view< Char > str ) const {
+      const auto set = std::wstring_view( symbols ).substr( 0, Base );
+      integer out;
+      out.digits.reserve( str.size() / chunk_digits + 1 );
+
+      limb value = 0, power = 1;
+      for ( auto c : str ) {
+        const auto digit = set.find( static_cast< wchar_t >( c ) );
+        assert( digit != std::wstring_view::npos && "not a digit of this base" );
+
+        value = value * Base + digit;
+        power *= Base;
+
+        if ( power == chunk_power ) {
+          out.mul_add( power, value );
+          value = 0;
+          power = 1;
+        }
+      }
 
-      for ( auto c : str )
-        digits.emplace( begin( digits ), set.find( static_cast< wchar_t >( c ) ) );
+      if ( power > 1 )
+        out.mul_add( power, value );
 
-      distribute( *this );
+      out.normalize();
+      return out;
     }
 
-    integer( std::wstring_view str ) {
-      using namespace std;
-      auto set = symbols.substr( 0, Base );
+    template < typename Char >
+    constexpr std::basic_string< Char > format() const {
+      assert( Base <= symbols.size() && "there is no symbol for every digit" );
 
-      for ( auto c : str )
-        digits.emplace( begin( digits ), set.find( c ) );
+      std::basic_string< Char > out;
+      out.reserve( digits.size() * chunk_digits + 2 );
 
-      distribute( *this );
+      if ( is_negativ )
+        out.push_back( Char( '-' ) );
+
+      integer magnitude    = *this;
+      magnitude.is_negativ = false;
+
+      std::vector< integer > powers;
+      size_t top = 0;
+      if ( digits.size() > limbs::radix_threshold ) {
+        // the first power above the magnitude
+        add_radix_powers( powers, 1 );
+        while ( powers.back() <= magnitude )
+          add_radix_powers( powers, powers.size() + 1 );
+        top = powers.size() - 2;
+      }
+
+      write_digits( magnitude, powers, top, false, out );
+      return out;
     }
 
-    integer( long long value, const std::wstring& s ) : symbols( s ) {
-      if ( value < 0 ) {
-        value      = -value;
-        is_negativ = !is_negativ;
+    // appends the symbols of 'n' < powers[k + 1], which has chunk_digits * 2^( k + 1 )
+    // digits. With 'pad' they are all written, leading zeros included.
+    template < typename Char >
+    constexpr void write_digits( const integer& n, const std::vector< integer >& powers,
+                                 size_t k, bool pad, std::basic_string< Char >& out ) const {
+      const size_t width = pad ? chunk_digits << ( k + 1 ) : 0;
+
+      if ( n.digits.size() <= limbs::radix_threshold ) {
+        write_chunks( n, width, out );
+        return;
       }
 
-      while ( value != 0 ) {
-        digits.emplace_back( static_cast< size_t >( value ) % Base );
-        value /= Base;
+      // n is large, so k > 0
+      const auto [high, low] = divmod( n, powers[k] );
+
+      if ( !pad && high.digits.empty() ) {
+        write_digits( low, powers, k - 1, false, out );
+      } else {
+        write_digits( high, powers, k - 1, pad, out );
+        write_digits( low, powers, k - 1, true, out );
       }
     }
 
-    template < size_t Size >
-    integer( size_t ( &value )[Size], const std::wstring& s ) : symbols( s ) {
-      digits.reserve( Size );
-      for ( int i = 0; i < Size; i++ )
-        digits[i] = value[i];
+    // appends at least 'width' symbols of 'n', one division per chunk of digits
+    template < typename Char >
+    constexpr void write_chunks( const integer& n, size_t width,
+                                 std::basic_string< Char >& out ) const {
+      const auto start = out.size();
+
+      // the symbols come out least significant first
+      limbs::limb_vector rest = n.digits;
+      while ( !rest.empty() ) {
+        limb chunk = limbs::divrem_1( rest.data(), rest.data(), rest.size(), chunk_power );
+        if ( rest.back() == 0 )
+          rest.pop_back();
+
+        // the most significant chunk is not padded with zeros
+        for ( size_t i = 0; i < chunk_digits && ( chunk != 0 || !rest.empty() ); ++i ) {
+          out.push_back( static_cast< Char >( symbols[chunk % Base] ) );
+          chunk /= Base;
+        }
+      }
+
+      while ( out.size() - start < std::max< size_t >( width, 1 ) )
+        out.push_back( static_cast< Char >( symbols[0] ) );
 
-      distribute( *this );
+      std::reverse( out.begin() + static_cast< std::ptrdiff_t >( start ), out.end() );
     }
 
-    integer( std::vector< size_t > v, const std::wstring& s ) : symbols( s ), digits( v ) {
-      distribute( *this );
+    // *this += n if 'n_negativ' is the sign of n, *this -= n if it is the
+    // opposite one. Works in place, 'n' may be *this.
+    constexpr integer& add_assign( const integer& n, bool n_negativ ) {
+      const size_t size   = digits.size();
+      const size_t n_size = n.digits.size();
+
+      if ( size == 0 )
+        is_negativ = n_negativ;
+
+      if ( is_negativ == n_negativ ) {
+        digits.resize( std::max( size, n_size ) + 1 );
+        auto data = digits.data();
+        data[digits.size() - 1] =
+          limbs::add( data, data, digits.size() - 1, n.digits.data(), n_size );
+      } else if ( limbs::compare( digits.data(), size, n.digits.data(), n_size ) >= 0 ) {
+        limbs::sub( digits.data(), digits.data(), size, n.digits.data(), n_size );
+      } else {
+        // |n| - |*this|, n is a different object here
+        digits.resize( n_size );
+        limbs::sub( digits.data(), n.digits.data(), n_size, digits.data(), n_size );
+        is_negativ = n_negativ;
+      }
+
+      normalize();
+      return *this;
     }
 
-    integer( const integer& n ) :
-        is_negativ( n.is_negativ ), digits( n.digits ), symbols( n.symbols ) { }
+    // a copy of *this with room for 'count' limbs
+    constexpr integer copy_with_capacity( size_t count ) const {
+      integer out;
+      out.digits.reserve( count );
+      out.digits.assign( digits.begin(), digits.end() );
+      out.is_negativ = is_negativ;
+      out.symbols    = symbols;
+      return out;
+    }
 
-    integer( integer&& n ) noexcept {
-      digits     = std::move( n.digits );
-      symbols    = std::move( n.symbols );
-      is_negativ = n.is_negativ;
+  public:
+    constexpr integer() = default;
+
+    template < std::integral I >
+    constexpr integer( I value ) {
+      assign( value );
     }
 
-    integer& operator=( long long value ) {
-      if ( value < 0 ) {
-        value      = -value;
-        is_negativ = true;
-      } else {
-        is_negativ = false;
-      }
+    template < size_t Size >
+    constexpr integer( size_t ( &value )[Size] ) {
+      assign_digits( value, Size );
+    }
 
-      digits.clear();
-      do {
-        digits.emplace_back( static_cast< size_t >( value ) % Base );
-        value /= Base;
-      } while ( value != 0 );
-      distribute( *this );
+    constexpr integer( const std::vector< size_t >& v ) { assign_digits( v.data(), v.size() ); }
 
-      return *this;
+    constexpr integer( std::string_view str ) { parse( str ); }
+
+    constexpr integer( std::wstring_view str ) { parse( str ); }
+
+    template < std::integral I >
+    integer( I value, const std::wstring& s ) : symbols( detail::intern_symbols( s ) ) {
+      assign( value );
     }
 
-    integer& operator=( const integer& value ) {
-      using namespace std;
-      digits.clear();
-      copy( begin( value.digits ), end( value.digits ), begin( digits ) );
-      copy( begin( value.symbols ), end( value.symbols ), begin( symbols ) );
-      is_negativ = value.is_negativ;
+    template < size_t Size >
+    integer( size_t ( &value )[Size], const std::wstring& s ) :
+        symbols( detail::intern_symbols( s ) ) {
+      assign_digits( value, Size );
+    }
 
-      distribute( *this );
+    integer( const std::vector< size_t >& v, const std::wstring& s ) :
+        symbols( detail::intern_symbols( s ) ) {
+      assign_digits( v.data(), v.size() );
+    }
+
+    constexpr integer( const integer& n ) = default;
+
+    // the source is left as zero, a moved from -5 is not -0
+    constexpr integer( integer&& n ) noexcept :
+        is_negativ( std::exchange( n.is_negativ, false ) ), digits( std::move( n.digits ) ),
+        symbols( n.symbols ) { }
+
+    template < std::integral I >
+    constexpr integer& operator=( I value ) {
+      assign( value );
       return *this;
     }
 
-    integer& operator=( integer&& value ) noexcept {
-      digits.clear();
-      digits     = std::move( value.digits );
-      symbols    = std::move( value.symbols );
-      is_negativ = value.is_negativ;
+    constexpr integer& operator=( const integer& value ) = default;
 
-      distribute( *this );
+    constexpr integer& operator=( integer&& value ) noexcept {
+      is_negativ = std::exchange( value.is_negativ, false );
+      digits     = std::move( value.digits );
+      symbols    = value.symbols;
       return *this;
     }
 
     // casting number<Base> to a diffenrent Type
 
-    // implicit cast
+    // implicit cast, the limbs don't depend on the base
     template < size_t B >
-    operator integer< B >() const {
+    constexpr operator integer< B >() const {
       integer< B > out;
-      out.digits.reserve( digits.capacity() );
-      out.digits.resize( digits.size() );
+      out.is_negativ = is_negativ;
+      out.digits     = digits;
+      return out;
+    }
 
-      const double base_from = static_cast< double >( Base );
-      const double base_to   = static_cast< double >( B );
+    // explicit cast, integral types keep the low bits like the built in
+    // conversions do
+    template < typename T >
+      requires std::is_arithmetic_v< T >
+    constexpr explicit operator T() const {
+      if constexpr ( std::same_as< T, bool > ) {
+        return !digits.empty();
+      } else if constexpr ( std::is_floating_point_v< T > ) {
+        T out = 0;
+        for ( auto i = digits.size(); i > 0; --i )
+          out = out * T( 0x1p64 ) + static_cast< T >( digits[i - 1] );
+
+        return is_negativ ? -out : out;
+      } else {
+        using U         = std::make_unsigned_t< T >;
+        const auto bits = static_cast< size_t >( std::numeric_limits< U >::digits );
+        U out           = 0;
 
-      const double base_factor = std::log( base_from / base_to );
+        for ( size_t i = 0; i < digits.size() && i * limbs::limb_bits < bits; ++i )
+          out |= static_cast< U >( static_cast< U >( digits[i] ) << ( i * limbs::limb_bits ) );
 
-      auto converter = [index = digits.size() - 1, base_factor,
-                        rest  = 0.0]( size_t a_i ) mutable -> size_t {
-        // a_i * Base^i = b_i * B^i
-        // => b_i = a_i * (Base / B)^i
-        // => b_i = a_i * exp(i * ln(Base / B))
-        // NOTE: b_i is likely not an integer
+        if ( is_negativ )
+          out = U( 0 ) - out;
 
-        auto b_i = std::exp( static_cast< double >( index-- ) * base_factor +
-                             std::log( static_cast< double >( a_i ) ) );
+        return static_cast< T >( out );
+      }
+    }
 
-        size_t new_value = static_cast< size_t >( b_i + rest * B );
-        rest             = b_i + rest * B - static_cast< double >( new_value );
+    constexpr explicit operator std::wstring() const { return format< wchar_t >(); }
 
-        if ( index + 1 == 0 && rest >= 0.5 ) {
-          ++new_value;
-          rest = 0.0;
-        }
-
-        return new_value;
-      };
+    constexpr explicit operator std::string() const { return format< char >(); }
+    // end of casting
 
-      std::transform( digits.rbegin(), digits.rend(), out.digits.rbegin(), converter );
+    void set_symbols( const std::wstring& s ) { symbols = detail::intern_symbols( s ); }
 
-      integer< B >::distribute( out );
+    // number of digits in base 'Base', without the sign
+    auto digit_count() const { return format< char >().size() - ( is_negativ ? 1 : 0 ); }
 
-      return out;
+    // the magnitude as little endian 64 bit limbs, without leading zeros
+    constexpr std::span< const limb > magnitude() const noexcept {
+      return { digits.data(), digits.size() };
     }
 
-    // explicit cast
-    template < typename T >
-    explicit operator T() const {
-      T exp = 1, out = 0;
+    constexpr bool negativ() const noexcept { return is_negativ; }
 
-      for ( auto n : digits ) {
-        out += exp * n;
-        exp *= Base;
-      }
+    // number of bits of the magnitude, 0 for 0
+    constexpr size_t bit_width() const noexcept {
+      if ( digits.empty() )
+        return 0;
+      return ( digits.size() - 1 ) * limbs::limb_bits +
+             static_cast< size_t >( std::bit_width( digits.back() ) );
+    }
 
-      if ( is_negativ )
-        out = -out;
+    static constexpr integer from_limbs( std::span< const limb > magnitude, bool negativ = false ) {
+      // leading zeros are dropped first, so small values stay inline
+      const size_t size = limbs::detail::normalized_size( magnitude.data(), magnitude.size() );
 
+      integer out;
+      out.digits.assign( magnitude.data(), magnitude.data() + size );
+      out.is_negativ = negativ;
+      out.normalize();
       return out;
     }
 
-    explicit operator std::wstring() const {
-      std::wstring out = L"";
-      out.reserve( digits.capacity() );
+    static constexpr integer negativ_of( const integer& n ) { return -n; }
 
-      for ( auto n : digits )
-        out.insert( std::begin( out ), symbols[n] );
+    constexpr integer operator-() const {
+      integer out    = *this;
+      out.is_negativ = !digits.empty() && !is_negativ;
+      return out;
+    }
 
-      while ( out[0] == L'0' && out.size() > 1 )
-        out.erase( 0, 1 );
+    constexpr bool operator==( const integer& n ) const noexcept {
+      return is_negativ == n.is_negativ && digits == n.digits;
+    }
 
-      if ( is_negativ )
-        out.insert( std::begin( out ), L'-' );
+    constexpr std::strong_ordering operator<=>( const integer& n ) const noexcept {
+      if ( is_negativ != n.is_negativ )
+        return is_negativ ? std::strong_ordering::less : std::strong_ordering::greater;
 
-      return out;
+      const int order =
+        limbs::compare( digits.data(), digits.size(), n.digits.data(), n.digits.size() );
+      return is_negativ ? 0 <=> order : order <=> 0;
     }
 
-    explicit operator std::string() const {
-      std::string out = "";
-      out.reserve( digits.capacity() );
+    // compound assignments work in place, the limbs are only reallocated if
+    // the result does not fit them
 
-      for ( auto n : digits )
-        out.insert( std::begin( out ), static_cast< char >( symbols[n] ) );
+    constexpr integer& operator+=( const integer& n ) { return add_assign( n, n.is_negativ ); }
 
-      while ( out[0] == '0' && out.size() > 1 )
-        out.erase( 0, 1 );
+    constexpr integer& operator-=( const integer& n ) { return add_assign( n, !n.is_negativ ); }
 
-      if ( is_negativ )
-        out.insert( std::begin( out ), '-' );
+    constexpr integer& operator*=( const integer& n ) {
+      if ( n.digits.size() != 1 )
+        return *this = *this * n;
 
-      return out;
+      // a single limb factor, e.g. the base when accumulating digits
+      const limb factor    = n.digits[0];
+      const bool n_negativ = n.is_negativ;
+      const limb carry     = limbs::mul_1( digits.data(), digits.data(), digits.size(), factor );
+      if ( carry != 0 )
+        digits.push_back( carry );
+
+      is_negativ = is_negativ != n_negativ;
+      normalize();
+      return *this;
     }
-    // end of casting
 
-    void set_symbols( const std::wstring& s ) { symbols = s; }
+    constexpr integer& operator/=( const integer& n ) {
+      if ( n.digits.size() != 1 )
+        return *this = divmod( *this, n ).first;
 
-    auto digit_count() const noexcept { return digits.size(); }
+      const limb divisor   = n.digits[0];
+      const bool n_negativ = n.is_negativ;
+      limbs::divrem_1( digits.data(), digits.data(), digits.size(), divisor );
 
-    static integer negativ_of( const integer& n ) {
-      integer out    = n;
-      out.is_negativ = !out.is_negativ;
-      return out;
+      is_negativ = is_negativ != n_negativ;
+      normalize();
+      return *this;
     }
 
-    integer operator+( const integer& n ) const {
-      if ( n.is_negativ ) {
-        return *this - negativ_of( n );
-      } else if ( this->is_negativ ) {
-        return n - negativ_of( *this );
-      } else {
-        integer tmp;
-        auto size = std::max( digits.size(), n.digits.size() );
+    constexpr integer& operator%=( const integer& n ) {
+      if ( n.digits.size() != 1 )
+        return *this = divmod( *this, n ).second;
 
-        tmp.digits.reserve( size + 1 );
-        tmp.digits.resize( size );
+      const limb rest =
+        limbs::divrem_1( digits.data(), digits.data(), digits.size(), n.digits[0] );
+      digits.clear();
+      digits.push_back( rest );
 
-        auto this_iter  = digits.begin();
-        auto other_iter = n.digits.begin();
-        auto temp_iter  = tmp.digits.begin();
+      normalize();
+      return *this;
+    }
 
-        while ( this_iter < digits.end() || other_iter < n.digits.end() ) {
-          if ( this_iter >= digits.end() )
-            *temp_iter = *other_iter;
-          else if ( other_iter >= n.digits.end() )
-            *temp_iter = *this_iter;
-          else
-            *temp_iter = ( *this_iter ) + ( *other_iter );
+    // multiplies by 2^bits
+    constexpr integer& operator<<=( size_t bits ) {
+      if ( digits.empty() )
+        return *this;
 
-          if ( this_iter != digits.end() )
-            ++this_iter;
+      const size_t whole = bits / limbs::limb_bits;
+      const auto part    = static_cast< unsigned >( bits % limbs::limb_bits );
+      const size_t size  = digits.size();
 
-          if ( other_iter != n.digits.end() )
-            ++other_iter;
+      digits.resize( size + whole + 1 );
+      auto data          = digits.data();
+      data[size + whole] = limbs::lshift( data + whole, data, size, part );
+      std::fill( data, data + whole, limb( 0 ) );
 
-          ++temp_iter;
-        }
+      normalize();
+      return *this;
+    }
 
-        distribute( tmp );
-        return tmp;
+    // divides by 2^bits rounding toward negative infinity, like the built in
+    // shift of a negative number
+    constexpr integer& operator>>=( size_t bits ) {
+      const size_t whole = bits / limbs::limb_bits;
+      const auto part    = static_cast< unsigned >( bits % limbs::limb_bits );
+      const size_t size  = digits.size();
+      auto data          = digits.data();
+
+      // a negative number moves down by one more if any 1 bit is shifted out
+      bool inexact = false;
+      for ( size_t i = 0; i < std::min( whole, size ); ++i )
+        inexact = inexact || data[i] != 0;
+
+      if ( whole >= size ) {
+        digits.clear();
+      } else {
+        inexact = limbs::rshift( data, data + whole, size - whole, part ) != 0 || inexact;
+        digits.resize( size - whole );
       }
-    }
 
-    integer operator-( const integer& n ) const {
-      size_t old_carry = 0, new_carry = 0;
-      integer tmp = *this;
-      size_t size = std::max( digits.size(), n.digits.size() );
-
-      for ( size_t i = 0; i < size; i++ ) {
-        old_carry = new_carry;
-        new_carry = 0;
-        if ( tmp.digits[i] == 0 && i == size - 1 ) {
-          tmp.is_negativ = !tmp.is_negativ;
-        } else if ( static_cast< long long >( tmp.digits[i] ) -
-                      static_cast< long long >( n.digits[i] + old_carry ) <
-                    0 ) {
-          ( tmp.digits[i] += Base ) -= ( n.digits[i] + old_carry );
-          new_carry++;
-        } else {
-          tmp.digits[i] -= ( n.digits[i] + old_carry );
-        }
+      if ( is_negativ && inexact ) {
+        const limb carry = limbs::add_1( digits.data(), digits.data(), digits.size(), 1 );
+        if ( carry != 0 )
+          digits.push_back( carry );
       }
-      return tmp;
+
+      normalize();
+      return *this;
     }
 
-    integer operator*( long long n ) const {
-      integer tmp = *this;
+    // the binary operators on an rvalue reuse its limbs for the result
 
-      for ( auto&& m : tmp.digits )
-        m *= n;
+    constexpr integer operator+( const integer& n ) const& {
+      auto out = copy_with_capacity( std::max( digits.size(), n.digits.size() ) + 1 );
+      out += n;
+      return out;
+    }
 
-      distribute( tmp );
-      return tmp;
+    constexpr integer operator+( const integer& n ) && { return std::move( *this += n ); }
+
+    constexpr integer operator-( const integer& n ) const& {
+      auto out = copy_with_capacity( std::max( digits.size(), n.digits.size() ) + 1 );
+      out -= n;
+      return out;
     }
 
-    integer operator*( const integer& n ) const {
+    constexpr integer operator-( const integer& n ) && { return std::move( *this -= n ); }
+
+    constexpr integer operator*( long long n ) const { return *this * integer( n ); }
+
+    constexpr integer operator*( const integer& n ) const& {
       integer tmp;
-      auto this_size  = digits.size();
-      auto other_size = n.digits.size();
-      tmp.digits.reserve( digits.capacity() + n.digits.capacity() );
-      tmp.digits.resize( this_size + other_size );
+      if ( digits.empty() || n.digits.empty() )
+        return tmp;
 
-      std::fill( tmp.digits.begin(), tmp.digits.end(), 0 );
+      tmp.digits.resize( digits.size() + n.digits.size() );
+      limbs::mul( tmp.digits.data(), digits.data(), digits.size(), n.digits.data(),
+                  n.digits.size() );
 
-      for ( size_t i = 0; i < this_size; ++i ) {
-        for ( size_t j = 0; j < other_size; ++j ) {
-          tmp.digits[i + j] += digits[i] * n.digits[j];
-        }
+      tmp.is_negativ = is_negativ ^ n.is_negativ;
+      tmp.normalize();
+      return tmp;
+    }
+
+    constexpr integer operator*( const integer& n ) && { return std::move( *this *= n ); }
+
+    // the quotient rounded toward zero and the remainder with the sign of 'n',
+    // like the built in integers do
+    friend constexpr std::pair< integer, integer > divmod( const integer& n, const integer& d ) {
+      assert( !d.digits.empty() && "division by zero" );
+
+      std::pair< integer, integer > out;
+      auto& [quotient, rest] = out;
+
+      const auto& x = n.digits;
+      const auto& y = d.digits;
+      if ( limbs::compare( x.data(), x.size(), y.data(), y.size() ) < 0 ) {
+        rest = n;
+        return out;
       }
 
-      tmp.is_negativ = is_negativ ^ n.is_negativ;
+      quotient.digits.resize( x.size() - y.size() + 1 );
+      rest.digits.resize( y.size() );
+      limbs::divrem( quotient.digits.data(), rest.digits.data(), x.data(), x.size(), y.data(),
+                     y.size() );
 
-      distribute( tmp );
-      return tmp;
+      quotient.is_negativ = n.is_negativ != d.is_negativ;
+      rest.is_negativ     = n.is_negativ;
+      quotient.normalize();
+      rest.normalize();
+      return out;
     }
 
-    // TODO: division (operator /)
-    integer operator/( const integer& n ) const { return integer(); }
+    constexpr integer operator/( const integer& n ) const& { return divmod( *this, n ).first; }
+
+    constexpr integer operator/( const integer& n ) && { return std::move( *this /= n ); }
+
+    constexpr integer operator%( const integer& n ) const& { return divmod( *this, n ).second; }
+
+    constexpr integer operator%( const integer& n ) && { return std::move( *this %= n ); }
+
+    constexpr integer operator<<( size_t bits ) const& {
+      auto out = copy_with_capacity( digits.size() + bits / limbs::limb_bits + 1 );
+      out <<= bits;
+      return out;
+    }
+
+    constexpr integer operator<<( size_t bits ) && { return std::move( *this <<= bits ); }
+
+    constexpr integer operator>>( size_t bits ) const& {
+      auto out = *this;
+      out >>= bits;
+      return out;
+    }
+
+    constexpr integer operator>>( size_t bits ) && { return std::move( *this >>= bits ); }
 
   private:
     template < size_t B >
@@ -372,11 +664,58 @@ namespace ds {
 
   // for calculations recommanded only
   // base exits default set of symbols
+  // these are radices, not widths. Fixed width integers are ds::wide_uint and
+  // ds::wide_int in wide_integer.hpp.
   using Int_64   = integer< 64 >;
   using Int_128  = integer< 128 >;
   using Int_256  = integer< 256 >;
   using Int_1024 = integer< 1024 >;
 
+  namespace detail {
+    // the limbs of an integer literal with an optional 0x, 0b or 0 prefix and
+    // ' separators. Every symbol adds at most 4 bits.
+    template < char... Chars >
+    consteval auto literal_limbs() {
+      constexpr char text[] = { Chars... };
+      constexpr size_t size = sizeof...( Chars );
+
+      limbs::limb base = 10;
+      size_t first     = 0;
+      if ( size > 1 && text[0] == '0' ) {
+        const bool hex = text[1] == 'x' || text[1] == 'X';
+        const bool bin = text[1] == 'b' || text[1] == 'B';
+        base           = hex ? 16 : bin ? 2 : 8;
+        first          = hex || bin ? 2 : 1;
+      }
+
+      std::array< limbs::limb, size * 4 / limbs::limb_bits + 1 > out{};
+      for ( size_t i = first; i < size; ++i ) {
+        if ( text[i] == '\'' )
+          continue;
+
+        const auto symbol = default_symbols.find( static_cast< wchar_t >(
+          text[i] >= 'a' && text[i] <= 'z' ? text[i] - 'a' + 'A' : text[i] ) );
+        assert( symbol < base && "not a digit of the literal's base" );
+
+        limbs::mul_1( out.data(), out.data(), out.size(), base );
+        limbs::add_1( out.data(), out.data(), out.size(), symbol );
+      }
+      return out;
+    }
+
+    template < char... Chars >
+    inline constexpr auto literal_value = literal_limbs< Chars... >();
+  } // namespace detail
+
+  namespace literals {
+    // 123456789012345678901234567890_bi. The limbs are computed while
+    // compiling, at run time they are only copied.
+    template < char... Chars >
+    constexpr Int operator""_bi() {
+      return Int::from_limbs( detail::literal_value< Chars... > );
+    }
+  } // namespace literals
+
   template < size_t Base, typename T >
   std::basic_ostream< T >& operator<<( std::basic_ostream< T >& str, const integer< Base >& n ) {
     using size_type = std::streamsize;
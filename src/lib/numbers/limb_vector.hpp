@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "../container/growth_policy.hpp"
+#include "limbs.hpp"
+
+namespace ds::limbs {
+  // the limbs of a number. Up to 'inline_capacity' limbs are stored inside
+  // the object, so values of up to 128 bits never touch the heap.
+  class limb_vector {
+  public:
+    static constexpr size_t inline_capacity = 2;
+
+    using value_type     = limb;
+    using iterator       = limb*;
+    using const_iterator = const limb*;
+
+  private:
+    using growth = ds::growth::geometric<>;
+
+    size_t Size     = 0;
+    size_t Capacity = inline_capacity;
+
+    union {
+      limb small[inline_capacity];
+      limb* heap;
+    };
+
+    constexpr bool is_inline() const noexcept { return Capacity == inline_capacity; }
+
+    // moves the limbs to a buffer of 'count' limbs
+    constexpr void reallocate( size_t count ) {
+      limb* buffer = std::allocator< limb >().allocate( count );
+      std::copy_n( data(), Size, buffer );
+
+      if ( !is_inline() )
+        std::allocator< limb >().deallocate( heap, Capacity );
+
+      heap     = buffer;
+      Capacity = count;
+    }
+
+    // a heap buffer is taken over, inline limbs are copied. *this is inline.
+    constexpr void take( limb_vector& other ) noexcept {
+      if ( other.is_inline() ) {
+        std::copy_n( other.small, other.Size, small );
+      } else {
+        heap           = std::exchange( other.heap, nullptr );
+        Capacity       = std::exchange( other.Capacity, inline_capacity );
+        other.small[0] = 0;
+      }
+      Size = std::exchange( other.Size, 0 );
+    }
+
+  public:
+    constexpr limb_vector() noexcept : small{} { }
+
+    constexpr limb_vector( size_t count, limb value ) : small{} { resize( count, value ); }
+
+    constexpr limb_vector( const limb* first, const limb* last ) : small{} {
+      assign( first, last );
+    }
+
+    constexpr limb_vector( const limb_vector& other ) : small{} {
+      assign( other.begin(), other.end() );
+    }
+
+    constexpr limb_vector( limb_vector&& other ) noexcept : small{} { take( other ); }
+
+    constexpr limb_vector& operator=( const limb_vector& other ) {
+      if ( this != std::addressof( other ) )
+        assign( other.begin(), other.end() );
+      return *this;
+    }
+
+    constexpr limb_vector& operator=( limb_vector&& other ) noexcept {
+      if ( this != std::addressof( other ) ) {
+        if ( !is_inline() )
+          std::allocator< limb >().deallocate( heap, Capacity );
+
+        Capacity = inline_capacity;
+        small[0] = 0;
+        take( other );
+      }
+      return *this;
+    }
+
+    constexpr ~limb_vector() {
+      if ( !is_inline() )
+        std::allocator< limb >().deallocate( heap, Capacity );
+    }
+
+    constexpr void assign( const limb* first, const limb* last ) {
+      const auto count = static_cast< size_t >( last - first );
+      Size             = 0;
+
+      reserve( count );
+      std::copy( first, last, data() );
+      Size = count;
+    }
+
+    constexpr limb* data() noexcept { return is_inline() ? small : heap; }
+
+    constexpr const limb* data() const noexcept { return is_inline() ? small : heap; }
+
+    constexpr size_t size() const noexcept { return Size; }
+
+    constexpr size_t capacity() const noexcept { return Capacity; }
+
+    constexpr bool empty() const noexcept { return Size == 0; }
+
+    constexpr limb& operator[]( size_t index ) noexcept { return data()[index]; }
+
+    constexpr const limb& operator[]( size_t index ) const noexcept { return data()[index]; }
+
+    constexpr limb& back() noexcept { return data()[Size - 1]; }
+
+    constexpr const limb& back() const noexcept { return data()[Size - 1]; }
+
+    constexpr iterator begin() noexcept { return data(); }
+
+    constexpr iterator end() noexcept { return data() + Size; }
+
+    constexpr const_iterator begin() const noexcept { return data(); }
+
+    constexpr const_iterator end() const noexcept { return data() + Size; }
+
+    constexpr void reserve( size_t count ) {
+      if ( count > Capacity )
+        reallocate( growth::next_capacity( Capacity, count ) );
+    }
+
+    // new limbs are set to 'value'
+    constexpr void resize( size_t count, limb value = 0 ) {
+      reserve( count );
+      if ( count > Size )
+        std::fill( data() + Size, data() + count, value );
+      Size = count;
+    }
+
+    constexpr void push_back( limb value ) {
+      reserve( Size + 1 );
+      data()[Size++] = value;
+    }
+
+    constexpr void pop_back() noexcept { --Size; }
+
+    // keeps the capacity
+    constexpr void clear() noexcept { Size = 0; }
+
+    constexpr bool operator==( const limb_vector& other ) const noexcept {
+      return std::equal( begin(), end(), other.begin(), other.end() );
+    }
+  };
+} // namespace ds::limbs
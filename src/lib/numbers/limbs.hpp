@@ -0,0 +1,632 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// operand sizes in limbs from which multiplication switches to the next
+// algorithm, tunable at compile time
+#ifndef DS_KARATSUBA_THRESHOLD
+#define DS_KARATSUBA_THRESHOLD 32
+#endif
+
+#ifndef DS_TOOM3_THRESHOLD
+#define DS_TOOM3_THRESHOLD 160
+#endif
+
+// divisor size in limbs from which division uses a Newton reciprocal, and the
+// size below which the reciprocal itself is computed by long division
+#ifndef DS_DIV_NEWTON_THRESHOLD
+#define DS_DIV_NEWTON_THRESHOLD 1200
+#endif
+
+#ifndef DS_RECIPROCAL_THRESHOLD
+#define DS_RECIPROCAL_THRESHOLD 100
+#endif
+
+// size in limbs below which numbers are parsed and printed one limb sized
+// chunk of digits at a time instead of divide and conquer
+#ifndef DS_RADIX_THRESHOLD
+#define DS_RADIX_THRESHOLD 40
+#endif
+
+namespace ds {
+  // kernels on little endian arrays of 64 bit limbs ( digits of base 2^64 ),
+  // shared by the arbitrary and fixed precision number types. Results may
+  // alias an input if they start at the same limb.
+  namespace limbs {
+    using limb = std::uint64_t;
+    __extension__ using dlimb = unsigned __int128;
+
+    inline constexpr unsigned limb_bits = 64;
+
+    inline constexpr size_t karatsuba_threshold  = DS_KARATSUBA_THRESHOLD;
+    inline constexpr size_t toom3_threshold      = DS_TOOM3_THRESHOLD;
+    inline constexpr size_t div_newton_threshold = DS_DIV_NEWTON_THRESHOLD;
+    inline constexpr size_t reciprocal_threshold = DS_RECIPROCAL_THRESHOLD;
+    inline constexpr size_t radix_threshold      = DS_RADIX_THRESHOLD;
+
+    static_assert( karatsuba_threshold >= 4 && toom3_threshold >= 3 * karatsuba_threshold / 2,
+                   "Toom-3 has to start after Karatsuba" );
+    static_assert( radix_threshold >= 2, "two limbs are always converted in chunks" );
+
+    // r = a + b, returns the carry
+    constexpr limb add_n( limb* r, const limb* a, const limb* b, size_t n ) noexcept {
+      limb carry = 0;
+      for ( size_t i = 0; i < n; ++i ) {
+        const dlimb sum = static_cast< dlimb >( a[i] ) + b[i] + carry;
+        r[i]            = static_cast< limb >( sum );
+        carry           = static_cast< limb >( sum >> limb_bits );
+      }
+      return carry;
+    }
+
+    // r = a + b for a single limb b, returns the carry
+    constexpr limb add_1( limb* r, const limb* a, size_t n, limb b ) noexcept {
+      for ( size_t i = 0; i < n; ++i ) {
+        r[i] = a[i] + b;
+        b    = r[i] < b ? 1 : 0;
+      }
+      return b;
+    }
+
+    // r = a - b, returns the borrow
+    constexpr limb sub_n( limb* r, const limb* a, const limb* b, size_t n ) noexcept {
+      limb borrow = 0;
+      for ( size_t i = 0; i < n; ++i ) {
+        const limb diff = a[i] - b[i];
+        const limb out  = diff - borrow;
+        borrow          = ( a[i] < b[i] ) | ( diff < borrow );
+        r[i]            = out;
+      }
+      return borrow;
+    }
+
+    // r = a - b for a single limb b, returns the borrow
+    constexpr limb sub_1( limb* r, const limb* a, size_t n, limb b ) noexcept {
+      for ( size_t i = 0; i < n; ++i ) {
+        const limb x = a[i];
+        r[i]         = x - b;
+        b            = x < b ? 1 : 0;
+      }
+      return b;
+    }
+
+    // r = a + b for an >= bn, returns the carry
+    constexpr limb add( limb* r, const limb* a, size_t an, const limb* b, size_t bn ) noexcept {
+      const limb carry = add_n( r, a, b, bn );
+      return add_1( r + bn, a + bn, an - bn, carry );
+    }
+
+    // r = a - b for an >= bn, returns the borrow
+    constexpr limb sub( limb* r, const limb* a, size_t an, const limb* b, size_t bn ) noexcept {
+      const limb borrow = sub_n( r, a, b, bn );
+      return sub_1( r + bn, a + bn, an - bn, borrow );
+    }
+
+    // r = a * b for a single limb b, returns the high limb
+    constexpr limb mul_1( limb* r, const limb* a, size_t n, limb b ) noexcept {
+      limb carry = 0;
+      for ( size_t i = 0; i < n; ++i ) {
+        const dlimb prod = static_cast< dlimb >( a[i] ) * b + carry;
+        r[i]             = static_cast< limb >( prod );
+        carry            = static_cast< limb >( prod >> limb_bits );
+      }
+      return carry;
+    }
+
+    // r += a * b for a single limb b, returns the carry out of r[n - 1]
+    constexpr limb addmul_1( limb* r, const limb* a, size_t n, limb b ) noexcept {
+      limb carry = 0;
+      for ( size_t i = 0; i < n; ++i ) {
+        const dlimb prod = static_cast< dlimb >( a[i] ) * b + r[i] + carry;
+        r[i]             = static_cast< limb >( prod );
+        carry            = static_cast< limb >( prod >> limb_bits );
+      }
+      return carry;
+    }
+
+    // r -= a * b for a single limb b, returns the borrow out of r[n - 1]
+    constexpr limb submul_1( limb* r, const limb* a, size_t n, limb b ) noexcept {
+      limb borrow = 0;
+      for ( size_t i = 0; i < n; ++i ) {
+        const dlimb prod = static_cast< dlimb >( a[i] ) * b + borrow;
+        const limb low   = static_cast< limb >( prod );
+        const limb x     = r[i];
+        r[i]             = x - low;
+        borrow           = static_cast< limb >( prod >> limb_bits ) + ( x < low ? 1 : 0 );
+      }
+      return borrow;
+    }
+
+    // r = a << shift for shift < 64, returns the bits shifted out. r may
+    // overlap 'a' if it starts at the same limb or above.
+    constexpr limb lshift( limb* r, const limb* a, size_t n, unsigned shift ) noexcept {
+      if ( shift == 0 ) {
+        for ( size_t i = n; i > 0; --i )
+          r[i - 1] = a[i - 1];
+        return 0;
+      }
+
+      if ( n == 0 )
+        return 0;
+
+      const limb out = a[n - 1] >> ( limb_bits - shift );
+      for ( size_t i = n - 1; i > 0; --i )
+        r[i] = ( a[i] << shift ) | ( a[i - 1] >> ( limb_bits - shift ) );
+      r[0] = a[0] << shift;
+      return out;
+    }
+
+    // r = a >> shift for shift < 64, returns the bits shifted out in the high
+    // bits of the limb. r may overlap 'a' if it starts at the same limb or below.
+    constexpr limb rshift( limb* r, const limb* a, size_t n, unsigned shift ) noexcept {
+      if ( shift == 0 ) {
+        for ( size_t i = 0; i < n; ++i )
+          r[i] = a[i];
+        return 0;
+      }
+
+      if ( n == 0 )
+        return 0;
+
+      const limb out = a[0] << ( limb_bits - shift );
+      for ( size_t i = 0; i + 1 < n; ++i )
+        r[i] = ( a[i] >> shift ) | ( a[i + 1] << ( limb_bits - shift ) );
+      r[n - 1] = a[n - 1] >> shift;
+      return out;
+    }
+
+    // r = a * b, r has an + bn limbs and must not overlap a or b
+    constexpr void mul_basecase( limb* r, const limb* a, size_t an, const limb* b,
+                                 size_t bn ) noexcept {
+      for ( size_t i = 0; i < an + bn; ++i )
+        r[i] = 0;
+
+      for ( size_t j = 0; j < bn; ++j )
+        r[an + j] = addmul_1( r + j, a, an, b[j] );
+    }
+
+    // r = a * b mod B^n, the low half of the product. r must not overlap a or b.
+    constexpr void mul_low( limb* r, const limb* a, const limb* b, size_t n ) noexcept {
+      for ( size_t i = 0; i < n; ++i )
+        r[i] = 0;
+
+      for ( size_t j = 0; j < n; ++j )
+        addmul_1( r + j, a, n - j, b[j] );
+    }
+
+    // q = a / d, returns a % d. q may be a.
+    constexpr limb divrem_1( limb* q, const limb* a, size_t n, limb d ) noexcept {
+      limb rest = 0;
+      for ( size_t i = n; i > 0; --i ) {
+        const dlimb cur = ( static_cast< dlimb >( rest ) << limb_bits ) | a[i - 1];
+        q[i - 1]        = static_cast< limb >( cur / d );
+        rest            = static_cast< limb >( cur % d );
+      }
+      return rest;
+    }
+
+    // compares two arrays of the same length, returns -1, 0 or 1
+    constexpr int compare_n( const limb* a, const limb* b, size_t n ) noexcept {
+      for ( size_t i = n; i > 0; --i )
+        if ( a[i - 1] != b[i - 1] )
+          return a[i - 1] < b[i - 1] ? -1 : 1;
+
+      return 0;
+    }
+
+    // compares two normalized numbers ( no leading zero limbs )
+    constexpr int compare( const limb* a, size_t an, const limb* b, size_t bn ) noexcept {
+      if ( an != bn )
+        return an < bn ? -1 : 1;
+
+      return compare_n( a, b, an );
+    }
+
+    constexpr void mul( limb* r, const limb* a, size_t an, const limb* b, size_t bn );
+
+    namespace detail {
+      // number of limbs without the leading zeros
+      constexpr size_t normalized_size( const limb* a, size_t n ) noexcept {
+        while ( n > 0 && a[n - 1] == 0 )
+          --n;
+        return n;
+      }
+
+      // an >= 2 * bn: 'a' is multiplied in pieces of bn limbs, so each partial
+      // product is balanced again
+      constexpr void mul_unbalanced( limb* r, const limb* a, size_t an, const limb* b,
+                                     size_t bn ) {
+        std::vector< limb > part( 2 * bn );
+
+        for ( size_t i = 0; i < an + bn; ++i )
+          r[i] = 0;
+
+        for ( size_t offset = 0; offset < an; offset += bn ) {
+          const size_t len = an - offset < bn ? an - offset : bn;
+          mul( part.data(), a + offset, len, b, bn );
+          // r holds the product of the previous pieces, which ends below offset + bn
+          add_n( r + offset, r + offset, part.data(), len + bn );
+        }
+      }
+
+      // a * b = z2 B^2h + z1 B^h + z0 with z1 = ( a0 + a1 )( b0 + b1 ) - z2 - z0,
+      // for h < bn <= an <= 2h
+      constexpr void mul_karatsuba( limb* r, const limb* a, size_t an, const limb* b,
+                                    size_t bn ) {
+        const size_t h = ( an + 1 ) / 2;
+        std::vector< limb > scratch( 4 * h + 4 );
+        limb* sa = scratch.data();
+        limb* sb = sa + h + 1;
+        limb* z1 = sb + h + 1;
+
+        sa[h] = add( sa, a, h, a + h, an - h );
+        sb[h] = add( sb, b, h, b + h, bn - h );
+        mul( z1, sa, h + 1, sb, h + 1 );
+
+        mul( r, a, h, b, h );                          // z0
+        mul( r + 2 * h, a + h, an - h, b + h, bn - h ); // z2
+
+        sub( z1, z1, 2 * h + 2, r, 2 * h );
+        sub( z1, z1, 2 * h + 2, r + 2 * h, an + bn - 2 * h );
+
+        // z1 < B^( an + bn - h ), its upper limbs are zero
+        add( r + h, r + h, an + bn - h, z1, normalized_size( z1, 2 * h + 2 ) );
+      }
+
+      // sign and magnitude, for the intermediate values of Toom-3 which may be
+      // negative
+      struct signed_limbs {
+        std::vector< limb > mag; // without leading zeros
+        bool negative = false;
+
+        constexpr signed_limbs() = default;
+
+        constexpr signed_limbs( const limb* a, size_t n ) :
+            mag( a, a + normalized_size( a, n ) ) { }
+      };
+
+      constexpr signed_limbs add_signed( const signed_limbs& a, const signed_limbs& b,
+                                         bool b_negative ) {
+        signed_limbs out;
+        const auto& x = a.mag;
+        const auto& y = b.mag;
+
+        if ( a.negative == b_negative ) {
+          const bool x_longer = x.size() >= y.size();
+          const auto& l       = x_longer ? x : y;
+          const auto& s       = x_longer ? y : x;
+
+          out.mag.resize( l.size() + 1 );
+          out.mag.back() = add( out.mag.data(), l.data(), l.size(), s.data(), s.size() );
+          out.negative   = b_negative;
+        } else {
+          const int order = compare( x.data(), x.size(), y.data(), y.size() );
+          if ( order == 0 )
+            return out;
+
+          const auto& l = order > 0 ? x : y;
+          const auto& s = order > 0 ? y : x;
+
+          out.mag.resize( l.size() );
+          sub( out.mag.data(), l.data(), l.size(), s.data(), s.size() );
+          out.negative = order > 0 ? a.negative : b_negative;
+        }
+
+        out.mag.resize( normalized_size( out.mag.data(), out.mag.size() ) );
+        return out;
+      }
+
+      constexpr signed_limbs operator+( const signed_limbs& a, const signed_limbs& b ) {
+        return add_signed( a, b, b.negative );
+      }
+
+      constexpr signed_limbs operator-( const signed_limbs& a, const signed_limbs& b ) {
+        return add_signed( a, b, !b.negative );
+      }
+
+      constexpr signed_limbs operator*( const signed_limbs& a, const signed_limbs& b ) {
+        signed_limbs out;
+        if ( a.mag.empty() || b.mag.empty() )
+          return out;
+
+        out.mag.resize( a.mag.size() + b.mag.size() );
+        mul( out.mag.data(), a.mag.data(), a.mag.size(), b.mag.data(), b.mag.size() );
+        out.mag.resize( normalized_size( out.mag.data(), out.mag.size() ) );
+        out.negative = a.negative != b.negative;
+        return out;
+      }
+
+      constexpr signed_limbs times_2( signed_limbs a ) {
+        a.mag.push_back( 0 );
+        a.mag.back() = addmul_1( a.mag.data(), a.mag.data(), a.mag.size() - 1, 1 );
+        a.mag.resize( normalized_size( a.mag.data(), a.mag.size() ) );
+        return a;
+      }
+
+      // exact division by a small 'd'
+      constexpr signed_limbs divide_exact( signed_limbs a, limb d ) {
+        divrem_1( a.mag.data(), a.mag.data(), a.mag.size(), d );
+        a.mag.resize( normalized_size( a.mag.data(), a.mag.size() ) );
+        return a;
+      }
+
+      // the polynomial of the three pieces of 'a' at 0, 1, -1, -2 and infinity
+      struct toom3_points {
+        signed_limbs at_0, at_1, at_m1, at_m2, at_inf;
+
+        constexpr toom3_points( const limb* a, size_t n, size_t k ) :
+            at_0( a, k ), at_inf( a + 2 * k, n - 2 * k ) {
+          const signed_limbs a1( a + k, k );
+          const auto even = at_0 + at_inf;
+
+          at_1  = even + a1;
+          at_m1 = even - a1;
+          at_m2 = times_2( at_m1 + at_inf ) - at_0;
+        }
+      };
+
+      // Toom-3 with the evaluation points and interpolation sequence of
+      // Bodrato, for 2k < bn <= an <= 3k
+      constexpr void mul_toom3( limb* r, const limb* a, size_t an, const limb* b, size_t bn ) {
+        const size_t k = ( an + 2 ) / 3;
+        const toom3_points p( a, an, k ), q( b, bn, k );
+
+        const auto r0   = p.at_0 * q.at_0;
+        const auto r_1  = p.at_1 * q.at_1;
+        const auto r_m1 = p.at_m1 * q.at_m1;
+        const auto r_m2 = p.at_m2 * q.at_m2;
+        const auto r4   = p.at_inf * q.at_inf;
+
+        auto r3 = divide_exact( r_m2 - r_1, 3 );
+        auto r1 = divide_exact( r_1 - r_m1, 2 );
+        auto r2 = r_m1 - r0;
+        r3      = divide_exact( r2 - r3, 2 ) + times_2( r4 );
+        r2      = r2 + r1 - r4;
+        r1      = r1 - r3;
+
+        // the coefficients of the product are not negative and their sum fits r
+        for ( size_t i = 0; i < an + bn; ++i )
+          r[i] = 0;
+
+        const signed_limbs* coefficients[] = { &r0, &r1, &r2, &r3, &r4 };
+        for ( size_t i = 0; i < 5; ++i ) {
+          const auto& c = coefficients[i]->mag;
+          if ( !c.empty() )
+            add( r + i * k, r + i * k, an + bn - i * k, c.data(), c.size() );
+        }
+      }
+    } // namespace detail
+
+    // r = a * b, r has an + bn limbs and must not overlap a or b. Picks
+    // schoolbook, Karatsuba or Toom-3 by the size of the operands.
+    constexpr void mul( limb* r, const limb* a, size_t an, const limb* b, size_t bn ) {
+      if ( an < bn ) {
+        std::swap( a, b );
+        std::swap( an, bn );
+      }
+
+      if ( bn < karatsuba_threshold )
+        mul_basecase( r, a, an, b, bn );
+      else if ( bn <= ( an + 1 ) / 2 )
+        detail::mul_unbalanced( r, a, an, b, bn );
+      else if ( bn >= toom3_threshold && bn > 2 * ( ( an + 2 ) / 3 ) )
+        detail::mul_toom3( r, a, an, b, bn );
+      else
+        detail::mul_karatsuba( r, a, an, b, bn );
+    }
+
+    namespace detail {
+      // Knuth's algorithm D. 'v' has n >= 2 limbs and its top bit set, the top
+      // n limbs of 'u' are less than 'v'. Writes the un - n limbs of u / v to
+      // 'q' and leaves u % v in the low n limbs of 'u'.
+      constexpr void div_knuth( limb* q, limb* u, size_t un, const limb* v, size_t n ) noexcept {
+        const limb v1 = v[n - 1];
+        const limb v2 = v[n - 2];
+
+        for ( size_t j = un - n; j > 0; --j ) {
+          limb* window = u + j - 1;
+
+          // estimate the quotient digit from the top limbs, it is at most two
+          // too large afterwards
+          const dlimb top = ( static_cast< dlimb >( window[n] ) << limb_bits ) | window[n - 1];
+          dlimb qhat      = top / v1;
+          dlimb rhat      = top % v1;
+
+          while ( qhat >> limb_bits != 0 ||
+                  qhat * v2 > ( ( rhat << limb_bits ) | window[n - 2] ) ) {
+            --qhat;
+            rhat += v1;
+            if ( rhat >> limb_bits != 0 )
+              break;
+          }
+
+          const limb borrow = submul_1( window, v, n, static_cast< limb >( qhat ) );
+          const limb high   = window[n];
+          window[n]         = high - borrow;
+
+          // the estimate was one too large, add 'v' back
+          if ( high < borrow ) {
+            --qhat;
+            window[n] += add_n( window, window, v, n );
+          }
+
+          q[j - 1] = static_cast< limb >( qhat );
+        }
+      }
+
+      constexpr signed_limbs power_of_base( size_t exponent ) {
+        signed_limbs out;
+        out.mag.assign( exponent + 1, 0 );
+        out.mag.back() = 1;
+        return out;
+      }
+
+      // drops the low 'count' limbs of the magnitude
+      constexpr signed_limbs shift_down( const signed_limbs& a, size_t count ) {
+        if ( a.mag.size() <= count )
+          return {};
+
+        signed_limbs out( a.mag.data() + count, a.mag.size() - count );
+        out.negative = a.negative;
+        return out;
+      }
+
+      // about floor( ( B^2n - 1 ) / v ) for 'v' of n limbs with its top bit set,
+      // off by a few units at most. The result has n + 1 limbs. Each Newton step
+      // doubles the precision of the reciprocal of the upper half of 'v', which
+      // keeps one guard limb so the error does not grow from step to step.
+      constexpr std::vector< limb > reciprocal( const limb* v, size_t n ) {
+        std::vector< limb > out( n + 1 );
+
+        if ( n < reciprocal_threshold || n < 4 ) {
+          std::vector< limb > u( 2 * n + 1, ~limb( 0 ) );
+          u.back() = 0;
+
+          if ( n == 1 )
+            divrem_1( out.data(), u.data(), 2, v[0] );
+          else
+            div_knuth( out.data(), u.data(), u.size(), v, n );
+          return out;
+        }
+
+        const size_t h     = n / 2 + 1;
+        const auto partial = reciprocal( v + n - h, h );
+
+        // with x0 = partial * B^( n - h ) the step x0 + x0 ( B^2n - v x0 ) / B^2n
+        // simplifies to
+        const signed_limbs x_h( partial.data(), h + 1 ), divisor( v, n );
+        const auto error = power_of_base( n + h ) - divisor * x_h;
+        auto x1          = shift_down( x_h * error, 2 * h );
+
+        signed_limbs x0;
+        x0.mag.assign( n - h, 0 );
+        x0.mag.insert( x0.mag.end(), partial.begin(), partial.end() );
+        x1 = x1 + x0;
+
+        for ( size_t i = 0; i < x1.mag.size() && i <= n; ++i )
+          out[i] = x1.mag[i];
+        return out;
+      }
+
+      // same contract as div_knuth. Every n limbs of the quotient come from one
+      // multiplication by the reciprocal of 'v' and one by 'v' ( Barrett ).
+      constexpr void div_barrett( limb* q, limb* u, size_t un, const limb* v, size_t n ) {
+        const auto inverse = reciprocal( v, n );
+        std::vector< limb > estimate( 2 * n + 3 ), product( 2 * n );
+
+        for ( size_t p = un - n; p > 0; ) {
+          const size_t k = p < n ? p : n;
+          p -= k;
+
+          // the n + k limbs at 'cur' are less than v * B^k
+          limb* cur = u + p;
+
+          // q ~ floor( floor( cur / B^( n - 1 ) ) * inverse / B^( n + 1 ) ), a few
+          // units off as the inverse is
+          mul( estimate.data(), cur + n - 1, k + 1, inverse.data(), n + 1 );
+          limb* digits = estimate.data() + n + 1;
+
+          // q < B^k
+          if ( digits[k] != 0 ) {
+            for ( size_t i = 0; i < k; ++i )
+              digits[i] = ~limb( 0 );
+          }
+
+          mul( product.data(), digits, k, v, n );
+          limb borrow = sub( cur, cur, n + k, product.data(), n + k );
+
+          // the estimate was too large
+          while ( borrow != 0 ) {
+            borrow -= add( cur, cur, n + k, v, n );
+            sub_1( digits, digits, k, 1 );
+          }
+
+          // the estimate was too small
+          while ( cur[n] != 0 || compare_n( cur, v, n ) >= 0 ) {
+            cur[n] -= sub_n( cur, cur, v, n );
+            add_1( digits, digits, k, 1 );
+          }
+
+          for ( size_t i = 0; i < k; ++i )
+            q[p + i] = digits[i];
+        }
+      }
+
+      template < bool Newton >
+      constexpr void divrem( limb* q, limb* r, const limb* a, size_t an, const limb* b,
+                             size_t bn ) {
+        if ( bn == 1 ) {
+          r[0] = divrem_1( q, a, an, b[0] );
+          return;
+        }
+
+        // shifts the divisor until its top bit is set, the remainder is
+        // shifted back afterwards
+        const auto shift = static_cast< unsigned >( std::countl_zero( b[bn - 1] ) );
+        std::vector< limb > v( bn ), u( an + 1 );
+
+        lshift( v.data(), b, bn, shift );
+        u[an] = lshift( u.data(), a, an, shift );
+
+        if ( Newton && bn >= div_newton_threshold && an - bn >= div_newton_threshold )
+          div_barrett( q, u.data(), an + 1, v.data(), bn );
+        else
+          div_knuth( q, u.data(), an + 1, v.data(), bn );
+
+        rshift( r, u.data(), bn, shift );
+      }
+    } // namespace detail
+
+    // q = a / b and r = a % b by long division, for an >= bn and b[bn - 1] != 0.
+    // q has an - bn + 1 limbs, r has bn limbs, neither overlaps the inputs.
+    constexpr void divrem_basecase( limb* q, limb* r, const limb* a, size_t an, const limb* b,
+                                    size_t bn ) {
+      detail::divrem< false >( q, r, a, an, b, bn );
+    }
+
+    // same as divrem_basecase, large divisors use a Newton reciprocal so the
+    // cost is a small multiple of a multiplication
+    constexpr void divrem( limb* q, limb* r, const limb* a, size_t an, const limb* b,
+                           size_t bn ) {
+      detail::divrem< true >( q, r, a, an, b, bn );
+    }
+
+    // -m^-1 mod 2^64 for an odd m, by Newton's iteration which doubles the
+    // number of correct bits each step ( m is its own inverse mod 8 )
+    constexpr limb montgomery_inverse( limb m ) noexcept {
+      limb inverse = m;
+      for ( int i = 0; i < 5; ++i )
+        inverse *= 2 - m * inverse;
+      return limb( 0 ) - inverse;
+    }
+
+    // r = a * b / B^n mod m for a, b < m, an odd m of n limbs and
+    // m_inverse = montgomery_inverse( m[0] ). 't' is scratch of 2n + 1 limbs,
+    // r may be a or b.
+    constexpr void montgomery_mul( limb* r, const limb* a, const limb* b, const limb* m,
+                                   size_t n, limb m_inverse, limb* t ) noexcept {
+      mul_basecase( t, a, n, b, n );
+      t[2 * n] = 0;
+
+      // adding a multiple of m clears the lowest limb of t + i, the sum
+      // stays below 2m * B^n
+      for ( size_t i = 0; i < n; ++i ) {
+        limb carry = addmul_1( t + i, m, n, t[i] * m_inverse );
+        for ( size_t j = i + n; carry != 0; ++j ) {
+          t[j] += carry;
+          carry = t[j] < carry ? 1 : 0;
+        }
+      }
+
+      if ( t[2 * n] != 0 || compare_n( t + n, m, n ) >= 0 )
+        sub_n( t + n, t + n, m, n );
+
+      for ( size_t i = 0; i < n; ++i )
+        r[i] = t[n + i];
+    }
+  } // namespace limbs
+} // namespace ds
@@ -0,0 +1,281 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "integer.hpp"
+#include "limb_vector.hpp"
+#include "limbs.hpp"
+
+namespace ds {
+  namespace detail {
+    // calls step( bit ) for the bits of 'exponent' from the highest set one down
+    template < typename Step >
+    constexpr void for_each_bit_down( std::span< const limbs::limb > exponent, Step step ) {
+      for ( size_t i = exponent.size(); i > 0; --i ) {
+        const auto top = i == exponent.size() ? std::bit_width( exponent[i - 1] )
+                                              : static_cast< int >( limbs::limb_bits );
+        for ( auto bit = top; bit > 0; --bit )
+          step( ( ( exponent[i - 1] >> ( bit - 1 ) ) & 1 ) != 0 );
+      }
+    }
+
+    // x mod m in [0, m)
+    template < size_t Base >
+    constexpr integer< Base > reduce( const integer< Base >& x, const integer< Base >& m ) {
+      auto rest = x % m;
+      if ( rest.negativ() )
+        rest += m;
+      return rest;
+    }
+  } // namespace detail
+
+  // base^exponent by repeated squaring
+  template < size_t Base >
+  constexpr integer< Base > pow( integer< Base > base, size_t exponent ) {
+    integer< Base > out = 1;
+
+    for ( ; exponent != 0; exponent >>= 1 ) {
+      if ( exponent & 1 )
+        out *= base;
+      if ( exponent > 1 )
+        base *= base;
+    }
+    return out;
+  }
+
+  // floor( sqrt( n ) ) for n >= 0 by Newton's iteration, which decreases
+  // from the first guess above the root until it reaches it
+  template < size_t Base >
+  constexpr integer< Base > isqrt( const integer< Base >& n ) {
+    assert( !n.negativ() && "square root of a negative number" );
+    if ( n == 0 )
+      return n;
+
+    auto x = integer< Base >( 1 ) << ( ( n.bit_width() + 1 ) / 2 );
+    while ( true ) {
+      auto y = ( x + n / x ) >> 1;
+      if ( y >= x )
+        return x;
+      x = std::move( y );
+    }
+  }
+
+  // Montgomery arithmetic modulo an odd number. Numbers in Montgomery form
+  // are multiplied without any division, so a chain of multiplications ( like
+  // in pow ) costs about as much as the plain products.
+  template < size_t Base = 10 >
+  class montgomery {
+    using limb = limbs::limb;
+
+    integer< Base > modulus;
+    limbs::limb_vector m;   // the limbs of the modulus
+    limb m_inverse = 0;
+    integer< Base > r2;     // B^2n mod m, converts into Montgomery form
+    integer< Base > one;    // 1 in Montgomery form
+
+    // the limbs of 0 <= x < m, padded to the length of m
+    constexpr limbs::limb_vector padded( const integer< Base >& x ) const {
+      const auto mag = x.magnitude();
+      limbs::limb_vector out( mag.data(), mag.data() + mag.size() );
+      out.resize( m.size() );
+      return out;
+    }
+
+    constexpr integer< Base > mul( const integer< Base >& a, const integer< Base >& b ) const {
+      const auto x = padded( a );
+      const auto y = padded( b );
+      limbs::limb_vector r( m.size(), 0 ), t( 2 * m.size() + 1, 0 );
+
+      limbs::montgomery_mul( r.data(), x.data(), y.data(), m.data(), m.size(), m_inverse,
+                             t.data() );
+      return integer< Base >::from_limbs( { r.data(), r.size() } );
+    }
+
+  public:
+    constexpr explicit montgomery( const integer< Base >& mod ) : modulus( mod ) {
+      const auto mag = mod.magnitude();
+      assert( !mod.negativ() && !mag.empty() && ( mag[0] & 1 ) != 0 &&
+              "Montgomery arithmetic needs a positive, odd modulus" );
+
+      m.assign( mag.data(), mag.data() + mag.size() );
+      m_inverse = limbs::montgomery_inverse( m[0] );
+
+      const auto r = integer< Base >( 1 ) << ( limbs::limb_bits * m.size() );
+      one          = r % modulus;
+      r2           = one * one % modulus;
+    }
+
+    constexpr const integer< Base >& get_modulus() const noexcept { return modulus; }
+
+    // x * B^n mod m, any integer is reduced first
+    constexpr integer< Base > to_form( const integer< Base >& x ) const {
+      return mul( detail::reduce( x, modulus ), r2 );
+    }
+
+    constexpr integer< Base > from_form( const integer< Base >& x ) const {
+      return mul( x, integer< Base >( 1 ) );
+    }
+
+    // the product of two numbers in Montgomery form, in Montgomery form
+    constexpr integer< Base > multiply( const integer< Base >& a,
+                                        const integer< Base >& b ) const {
+      return mul( a, b );
+    }
+
+    // base^exponent mod m for a normal ( not Montgomery form ) base
+    constexpr integer< Base > pow( const integer< Base >& base,
+                                   const integer< Base >& exponent ) const {
+      assert( !exponent.negativ() && "negative exponent" );
+
+      // the loop multiplies in place, without any allocation
+      const auto b = padded( to_form( base ) );
+      auto out     = padded( one );
+      limbs::limb_vector t( 2 * m.size() + 1, 0 );
+      const auto n = m.size();
+
+      detail::for_each_bit_down( exponent.magnitude(), [&]( bool bit ) {
+        limbs::montgomery_mul( out.data(), out.data(), out.data(), m.data(), n, m_inverse,
+                               t.data() );
+        if ( bit )
+          limbs::montgomery_mul( out.data(), out.data(), b.data(), m.data(), n, m_inverse,
+                                 t.data() );
+      } );
+      return from_form( integer< Base >::from_limbs( { out.data(), n } ) );
+    }
+  };
+
+  // Montgomery arithmetic for moduli of at most 'Limbs' limbs known at compile
+  // time. Numbers in Montgomery form are plain arrays, so multiplying them
+  // never allocates.
+  template < size_t Limbs >
+  class fixed_montgomery {
+  public:
+    using value_type = std::array< limbs::limb, Limbs >;
+
+  private:
+    value_type m{};
+    value_type r2{};
+    value_type one{};
+    limbs::limb m_inverse = 0;
+
+    template < size_t Base >
+    static constexpr value_type to_array( const integer< Base >& x ) {
+      const auto mag = x.magnitude();
+      assert( mag.size() <= Limbs && "the number does not fit the limbs" );
+
+      value_type out{};
+      std::copy( mag.begin(), mag.end(), out.begin() );
+      return out;
+    }
+
+  public:
+    template < size_t Base >
+    constexpr explicit fixed_montgomery( const integer< Base >& mod ) : m( to_array( mod ) ) {
+      assert( !mod.negativ() && ( m[0] & 1 ) != 0 &&
+              "Montgomery arithmetic needs a positive, odd modulus" );
+
+      m_inverse = limbs::montgomery_inverse( m[0] );
+
+      const auto r     = integer< Base >( 1 ) << ( limbs::limb_bits * Limbs );
+      const auto one_i = r % mod;
+      one              = to_array( one_i );
+      r2               = to_array( one_i * one_i % mod );
+    }
+
+    constexpr value_type multiply( const value_type& a, const value_type& b ) const noexcept {
+      value_type out;
+      std::array< limbs::limb, 2 * Limbs + 1 > scratch;
+      limbs::montgomery_mul( out.data(), a.data(), b.data(), m.data(), Limbs, m_inverse,
+                             scratch.data() );
+      return out;
+    }
+
+    // x * B^Limbs mod m, any integer is reduced first
+    template < size_t Base >
+    constexpr value_type to_form( const integer< Base >& x ) const {
+      const auto mod = integer< Base >::from_limbs( m );
+      return multiply( to_array( detail::reduce( x, mod ) ), r2 );
+    }
+
+    template < size_t Base = 10 >
+    constexpr integer< Base > from_form( const value_type& x ) const {
+      value_type unit{};
+      unit[0] = 1;
+      return integer< Base >::from_limbs( multiply( x, unit ) );
+    }
+
+    // base^exponent for 'base' in Montgomery form, the result is in it too
+    constexpr value_type pow( const value_type& base,
+                              std::span< const limbs::limb > exponent ) const {
+      auto out = one;
+      detail::for_each_bit_down( exponent, [&]( bool bit ) {
+        out = multiply( out, out );
+        if ( bit )
+          out = multiply( out, base );
+      } );
+      return out;
+    }
+
+    // base^exponent mod m for a normal ( not Montgomery form ) base
+    template < size_t Base >
+    constexpr integer< Base > pow( const integer< Base >& base,
+                                   const integer< Base >& exponent ) const {
+      assert( !exponent.negativ() && "negative exponent" );
+      return from_form< Base >( pow( to_form( base ), exponent.magnitude() ) );
+    }
+  };
+
+  // base^exponent mod modulus in [0, modulus). Odd moduli use Montgomery
+  // multiplication, even ones square and reduce by division.
+  template < size_t Base >
+  constexpr integer< Base > powmod( const integer< Base >& base, const integer< Base >& exponent,
+                                    const integer< Base >& modulus ) {
+    assert( !exponent.negativ() && "negative exponent" );
+    assert( !modulus.negativ() && modulus != 0 && "the modulus has to be positive" );
+
+    if ( modulus == 1 )
+      return 0;
+
+    if ( ( modulus.magnitude()[0] & 1 ) != 0 )
+      return montgomery< Base >( modulus ).pow( base, exponent );
+
+    const auto b = detail::reduce( base, modulus );
+    integer< Base > out = 1;
+    detail::for_each_bit_down( exponent.magnitude(), [&]( bool bit ) {
+      out = out * out % modulus;
+      if ( bit )
+        out = out * b % modulus;
+    } );
+    return out;
+  }
+
+  // the x in [0, modulus) with a * x = 1 mod modulus, if a and modulus are
+  // coprime ( extended Euclidean algorithm )
+  template < size_t Base >
+  constexpr std::optional< integer< Base > > mod_inverse( const integer< Base >& a,
+                                                          const integer< Base >& modulus ) {
+    assert( !modulus.negativ() && modulus != 0 && "the modulus has to be positive" );
+
+    // r_i = s_i * a mod modulus
+    integer< Base > r0 = modulus, r1 = detail::reduce( a, modulus );
+    integer< Base > s0 = 0, s1 = 1;
+
+    while ( r1 != 0 ) {
+      auto [q, r2] = divmod( r0, r1 );
+      auto s2      = s0 - q * s1;
+
+      r0 = std::exchange( r1, std::move( r2 ) );
+      s0 = std::exchange( s1, std::move( s2 ) );
+    }
+
+    if ( r0 != 1 )
+      return std::nullopt;
+    return detail::reduce( s0, modulus );
+  }
+} // namespace ds
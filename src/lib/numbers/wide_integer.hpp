@@ -0,0 +1,366 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include "integer.hpp"
+#include "limbs.hpp"
+
+namespace ds {
+  // integer of exactly 'Bits' bits in an array of 64 bit limbs, two's
+  // complement if 'Signed'. Arithmetic wraps around like the built in
+  // unsigned types do, nothing ever touches the heap.
+  template < size_t Bits, bool Signed >
+  class wide_integer {
+    static_assert( Bits > 0 && Bits % limbs::limb_bits == 0,
+                   "a wide integer is made of whole 64 bit limbs" );
+
+    template < size_t B, bool S >
+    friend class wide_integer;
+
+    using limb = limbs::limb;
+
+  public:
+    static constexpr size_t limb_count = Bits / limbs::limb_bits;
+
+    using limb_array = std::array< limb, limb_count >;
+
+  private:
+    limb_array words{}; // little endian
+
+    // limb filling the bits above the value, all ones for a negative one
+    constexpr limb extension() const noexcept {
+      return negativ() ? ~limb( 0 ) : limb( 0 );
+    }
+
+    // q = a / b and r = a % b for the unsigned values
+    static constexpr void divmod_unsigned( limb_array& q, limb_array& r, const limb_array& a,
+                                           const limb_array& b ) noexcept {
+      const size_t an = limbs::detail::normalized_size( a.data(), limb_count );
+      const size_t bn = limbs::detail::normalized_size( b.data(), limb_count );
+      assert( bn != 0 && "division by zero" );
+
+      q = limb_array{};
+      r = limb_array{};
+      if ( limbs::compare( a.data(), an, b.data(), bn ) < 0 ) {
+        r = a;
+        return;
+      }
+
+      if ( bn == 1 ) {
+        r[0] = limbs::divrem_1( q.data(), a.data(), an, b[0] );
+        return;
+      }
+
+      // long division on shifted copies, like limbs::divrem but on the stack
+      const auto shift = static_cast< unsigned >( std::countl_zero( b[bn - 1] ) );
+      limb_array v{};
+      std::array< limb, limb_count + 1 > u{};
+
+      limbs::lshift( v.data(), b.data(), bn, shift );
+      u[an] = limbs::lshift( u.data(), a.data(), an, shift );
+
+      limbs::detail::div_knuth( q.data(), u.data(), an + 1, v.data(), bn );
+      limbs::rshift( r.data(), u.data(), bn, shift );
+    }
+
+  public:
+    constexpr wide_integer() noexcept = default;
+
+    // negative values are sign extended, like converting them to an unsigned type
+    template < std::integral I >
+    constexpr wide_integer( I value ) noexcept {
+      using U = std::make_unsigned_t< I >;
+
+      words.fill( value < 0 ? ~limb( 0 ) : limb( 0 ) );
+      if constexpr ( std::numeric_limits< U >::digits <= limbs::limb_bits ) {
+        // a signed value is sign extended to the whole limb first
+        using L  = std::conditional_t< std::is_signed_v< I >, std::int64_t, limb >;
+        words[0] = static_cast< limb >( static_cast< L >( value ) );
+      } else {
+        auto bits = static_cast< U >( value );
+        for ( size_t i = 0; i < limb_count && bits != 0; ++i, bits >>= limbs::limb_bits )
+          words[i] = static_cast< limb >( bits );
+      }
+    }
+
+    constexpr explicit wide_integer( const limb_array& value ) noexcept : words( value ) { }
+
+    // keeps the low bits of a wider value, extends a narrower one
+    template < size_t B, bool S >
+    constexpr explicit wide_integer( const wide_integer< B, S >& value ) noexcept {
+      constexpr size_t count = std::min( limb_count, wide_integer< B, S >::limb_count );
+
+      std::copy_n( value.words.begin(), count, words.begin() );
+      std::fill( words.begin() + count, words.end(), value.extension() );
+    }
+
+    // keeps the low bits in two's complement, like the explicit integral cast
+    template < size_t Base >
+    constexpr explicit wide_integer( const integer< Base >& value ) {
+      const auto mag   = value.magnitude();
+      const auto count = std::min( limb_count, mag.size() );
+
+      std::copy_n( mag.begin(), count, words.begin() );
+      if ( value.negativ() )
+        *this = -*this;
+    }
+
+    template < size_t Base >
+    constexpr explicit operator integer< Base >() const {
+      if ( !negativ() )
+        return integer< Base >::from_limbs( words );
+      return integer< Base >::from_limbs( ( -*this ).words, true );
+    }
+
+    // keeps the low bits like the built in conversions do
+    template < std::integral T >
+    constexpr explicit operator T() const noexcept {
+      if constexpr ( std::same_as< T, bool > ) {
+        return *this != wide_integer();
+      } else {
+        using U             = std::make_unsigned_t< T >;
+        constexpr auto bits = static_cast< size_t >( std::numeric_limits< U >::digits );
+        U out               = 0;
+
+        for ( size_t i = 0; i < limb_count && i * limbs::limb_bits < bits; ++i )
+          out |= static_cast< U >( static_cast< U >( words[i] ) << ( i * limbs::limb_bits ) );
+
+        return static_cast< T >( out );
+      }
+    }
+
+    constexpr explicit operator std::string() const {
+      return static_cast< std::string >( static_cast< integer<> >( *this ) );
+    }
+
+    constexpr const limb_array& get_limbs() const noexcept { return words; }
+
+    constexpr bool negativ() const noexcept {
+      if constexpr ( Signed )
+        return ( words[limb_count - 1] >> ( limbs::limb_bits - 1 ) ) != 0;
+      else
+        return false;
+    }
+
+    static constexpr wide_integer max() noexcept {
+      wide_integer out;
+      out.words.fill( ~limb( 0 ) );
+      if constexpr ( Signed )
+        out.words[limb_count - 1] >>= 1;
+      return out;
+    }
+
+    static constexpr wide_integer min() noexcept {
+      wide_integer out;
+      if constexpr ( Signed )
+        out.words[limb_count - 1] = limb( 1 ) << ( limbs::limb_bits - 1 );
+      return out;
+    }
+
+    constexpr bool operator==( const wide_integer& ) const noexcept = default;
+
+    constexpr std::strong_ordering operator<=>( const wide_integer& n ) const noexcept {
+      if ( negativ() != n.negativ() )
+        return negativ() ? std::strong_ordering::less : std::strong_ordering::greater;
+
+      // values of the same sign compare like their unsigned bits
+      return limbs::compare_n( words.data(), n.words.data(), limb_count ) <=> 0;
+    }
+
+    constexpr wide_integer operator~() const noexcept {
+      wide_integer out;
+      for ( size_t i = 0; i < limb_count; ++i )
+        out.words[i] = ~words[i];
+      return out;
+    }
+
+    constexpr wide_integer operator-() const noexcept {
+      auto out = ~*this;
+      limbs::add_1( out.words.data(), out.words.data(), limb_count, 1 );
+      return out;
+    }
+
+    constexpr wide_integer& operator+=( const wide_integer& n ) noexcept {
+      limbs::add_n( words.data(), words.data(), n.words.data(), limb_count );
+      return *this;
+    }
+
+    constexpr wide_integer& operator-=( const wide_integer& n ) noexcept {
+      limbs::sub_n( words.data(), words.data(), n.words.data(), limb_count );
+      return *this;
+    }
+
+    // the low half of the product is the same for signed and unsigned values
+    constexpr wide_integer& operator*=( const wide_integer& n ) noexcept {
+      return *this = *this * n;
+    }
+
+    // the quotient rounded toward zero and the remainder with the sign of 'n',
+    // like the built in integers. The smallest value divided by -1 wraps.
+    friend constexpr std::pair< wide_integer, wide_integer >
+    divmod( const wide_integer& n, const wide_integer& d ) noexcept {
+      const bool n_negativ = n.negativ();
+      const bool d_negativ = d.negativ();
+      const auto a         = n_negativ ? -n : n;
+      const auto b         = d_negativ ? -d : d;
+
+      std::pair< wide_integer, wide_integer > out;
+      auto& [quotient, rest] = out;
+      divmod_unsigned( quotient.words, rest.words, a.words, b.words );
+
+      if ( n_negativ != d_negativ )
+        quotient = -quotient;
+      if ( n_negativ )
+        rest = -rest;
+      return out;
+    }
+
+    constexpr wide_integer& operator/=( const wide_integer& n ) noexcept {
+      return *this = divmod( *this, n ).first;
+    }
+
+    constexpr wide_integer& operator%=( const wide_integer& n ) noexcept {
+      return *this = divmod( *this, n ).second;
+    }
+
+    constexpr wide_integer& operator&=( const wide_integer& n ) noexcept {
+      for ( size_t i = 0; i < limb_count; ++i )
+        words[i] &= n.words[i];
+      return *this;
+    }
+
+    constexpr wide_integer& operator|=( const wide_integer& n ) noexcept {
+      for ( size_t i = 0; i < limb_count; ++i )
+        words[i] |= n.words[i];
+      return *this;
+    }
+
+    constexpr wide_integer& operator^=( const wide_integer& n ) noexcept {
+      for ( size_t i = 0; i < limb_count; ++i )
+        words[i] ^= n.words[i];
+      return *this;
+    }
+
+    // shifting by 'Bits' or more clears every bit
+    constexpr wide_integer& operator<<=( size_t bits ) noexcept {
+      const size_t whole = std::min( bits / limbs::limb_bits, limb_count );
+      const auto part    = static_cast< unsigned >( bits % limbs::limb_bits );
+
+      if ( whole < limb_count )
+        limbs::lshift( words.data() + whole, words.data(), limb_count - whole, part );
+      std::fill( words.begin(), words.begin() + whole, limb( 0 ) );
+      return *this;
+    }
+
+    // an arithmetic shift for signed values, it rounds toward negative infinity
+    constexpr wide_integer& operator>>=( size_t bits ) noexcept {
+      const limb fill    = extension();
+      const size_t whole = std::min( bits / limbs::limb_bits, limb_count );
+      const auto part    = static_cast< unsigned >( bits % limbs::limb_bits );
+      const size_t kept  = limb_count - whole;
+
+      if ( kept != 0 ) {
+        limbs::rshift( words.data(), words.data() + whole, kept, part );
+        if ( part != 0 )
+          words[kept - 1] |= fill << ( limbs::limb_bits - part );
+      }
+      std::fill( words.begin() + kept, words.end(), fill );
+      return *this;
+    }
+
+    constexpr wide_integer& operator++() noexcept { return *this += 1; }
+
+    constexpr wide_integer& operator--() noexcept { return *this -= 1; }
+
+    constexpr wide_integer operator++( int ) noexcept {
+      const auto out = *this;
+      ++*this;
+      return out;
+    }
+
+    constexpr wide_integer operator--( int ) noexcept {
+      const auto out = *this;
+      --*this;
+      return out;
+    }
+
+    // hidden friends, so a built in integer converts on either side
+
+    friend constexpr wide_integer operator+( wide_integer a, const wide_integer& b ) noexcept {
+      return a += b;
+    }
+
+    friend constexpr wide_integer operator-( wide_integer a, const wide_integer& b ) noexcept {
+      return a -= b;
+    }
+
+    friend constexpr wide_integer operator*( const wide_integer& a,
+                                             const wide_integer& b ) noexcept {
+      wide_integer out;
+      limbs::mul_low( out.words.data(), a.words.data(), b.words.data(), limb_count );
+      return out;
+    }
+
+    friend constexpr wide_integer operator/( const wide_integer& a,
+                                             const wide_integer& b ) noexcept {
+      return divmod( a, b ).first;
+    }
+
+    friend constexpr wide_integer operator%( const wide_integer& a,
+                                             const wide_integer& b ) noexcept {
+      return divmod( a, b ).second;
+    }
+
+    friend constexpr wide_integer operator&( wide_integer a, const wide_integer& b ) noexcept {
+      return a &= b;
+    }
+
+    friend constexpr wide_integer operator|( wide_integer a, const wide_integer& b ) noexcept {
+      return a |= b;
+    }
+
+    friend constexpr wide_integer operator^( wide_integer a, const wide_integer& b ) noexcept {
+      return a ^= b;
+    }
+
+    friend constexpr wide_integer operator<<( wide_integer a, size_t bits ) noexcept {
+      return a <<= bits;
+    }
+
+    friend constexpr wide_integer operator>>( wide_integer a, size_t bits ) noexcept {
+      return a >>= bits;
+    }
+  };
+
+  template < size_t Bits >
+  using wide_uint = wide_integer< Bits, false >;
+
+  template < size_t Bits >
+  using wide_int = wide_integer< Bits, true >;
+
+  using uint128 = wide_uint< 128 >;
+  using uint256 = wide_uint< 256 >;
+  using uint512 = wide_uint< 512 >;
+  using int128  = wide_int< 128 >;
+  using int256  = wide_int< 256 >;
+  using int512  = wide_int< 512 >;
+
+  static_assert( std::is_trivially_copyable_v< uint256 > && sizeof( uint256 ) == 32 );
+
+  template < size_t Bits, bool Signed, typename T >
+  std::basic_ostream< T >& operator<<( std::basic_ostream< T >& str,
+                                       const wide_integer< Bits, Signed >& n ) {
+    return str << static_cast< integer<> >( n );
+  }
+
+} // namespace ds
@@ -21,6 +21,25 @@ namespace ds {
     ->std::same_as< Iter >;
   };
 
+  // a pair of iterators usable in range based for loops, it owns nothing
+  template < typename Iter >
+  class iterator_range {
+  public:
+    using iterator = Iter;
+
+  private:
+    iterator first, last;
+
+  public:
+    iterator_range( iterator f, iterator l ) : first( f ), last( l ) { }
+
+    iterator begin() const { return first; }
+
+    iterator end() const { return last; }
+
+    bool is_empty() const { return first == last; }
+  };
+
   template < range R >
   inline std::ostream& operator<<( std::ostream& stream, const R& r ) {
     const auto begin = r.begin();
@@ -1,11 +1,51 @@
 
 #include <iostream>
+#include <string_view>
 
+#include "bench_funcs.hpp"
 #include "test_funcs.hpp"
 
-auto main() -> int {
+auto main( int argc, char** argv ) -> int {
+  // "<exe> bench" runs the benchmarks instead of the tests
+  if ( argc > 1 && std::string_view( argv[1] ) == "bench" ) {
+    bench::push_throughput();
+    bench::block_churn();
+    bench::segment_scan();
+    bench::front_and_middle();
+    bench::list_random_ops();
+    bench::list_positional_ops();
+    bench::tree_key_streams();
+    bench::ordered_containers();
+    bench::integer_multiply();
+    bench::integer_divide();
+    bench::integer_strings();
+    bench::integer_small_values();
+    bench::integer_modular();
+    bench::wide_integers();
+    bench::floatingpoint_sum();
+    return 0;
+  }
+
   test::output_range();
   test::stack();
+  test::list();
   test::vector();
   test::integer();
+  test::floatingpoint();
+  test::growth_policies();
+  test::construction();
+  test::pool_allocator();
+  test::segments();
+  test::bulk();
+  test::emplace();
+  test::indexed_list();
+  test::binarytree();
+  test::btree();
+  test::multiplication();
+  test::division();
+  test::radix_conversion();
+  test::modular();
+  test::wide_integer();
+
+  return test::failed_checks() == 0 ? 0 : 1;
 }
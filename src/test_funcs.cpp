@@ -1,17 +1,166 @@
-
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
+#include "algorithms.hpp"
+#include "container/binarytree.hpp"
+#include "container/block_pool.hpp"
+#include "container/btree.hpp"
+#include "container/data_manager.hpp"
 #include "container/list.hpp"
 #include "container/stack.hpp"
 #include "container/vector.hpp"
+#include "numbers/floatingpoint.hpp"
 #include "numbers/integer.hpp"
+#include "numbers/modular.hpp"
+#include "numbers/wide_integer.hpp"
 #include "range.hpp"
 
 #include "test_funcs.hpp"
 
 namespace test {
 
+  namespace {
+    size_t failures = 0;
+
+    // prints the result of a check, main returns an error if any failed
+    void check( const char* name, bool ok ) {
+      std::cout << ' ' << name << ": " << ( ok ? "ok" : "FAILED" ) << '\n';
+      if ( !ok )
+        ++failures;
+    }
+
+    // the table sizes a data_manager goes through while it grows to 'blocks'
+    // blocks one at a time, like a container pushing across block boundaries
+    template < typename Manager >
+    std::vector< size_t > table_sizes( size_t blocks ) {
+      Manager manager;
+      std::vector< size_t > sizes = { manager.block_capacity() };
+      while ( manager.block_count() < blocks ) {
+        manager.expand_by( 1 );
+        if ( manager.block_capacity() != sizes.back() )
+          sizes.push_back( manager.block_capacity() );
+      }
+      return sizes;
+    }
+
+    size_t callback_calls = 0;
+
+    // a growth callback which triples the table
+    size_t triple( size_t current, size_t ) {
+      ++callback_calls;
+      return current * 3;
+    }
+
+    // counts the living instances and how often any was copied or moved
+    struct tracked {
+      static inline long live      = 0;
+      static inline size_t copies = 0, moves = 0;
+
+      int a = 0, b = 0;
+
+      tracked( int x, int y ) : a( x ), b( y ) { ++live; }
+      tracked( const tracked& other ) : a( other.a ), b( other.b ) {
+        ++live;
+        ++copies;
+      }
+      tracked( tracked&& other ) noexcept : a( other.a ), b( other.b ) {
+        ++live;
+        ++moves;
+      }
+      tracked& operator=( const tracked& other ) = default;
+      tracked& operator=( tracked&& other ) noexcept = default;
+      ~tracked() { --live; }
+
+      bool operator==( const tracked& other ) const { return a == other.a; }
+      bool operator<( const tracked& other ) const { return a < other.a; }
+    };
+
+    // the elements of a vector or stack, from the front or the bottom
+    template < typename Container >
+    std::vector< int > contents( const Container& container ) {
+      std::vector< int > out;
+      for ( auto segment : container.segments() )
+        out.insert( out.end(), segment.begin(), segment.end() );
+      return out;
+    }
+
+    // the values of a ds::list in order
+    template < typename List >
+    std::vector< typename List::value_type > values_of( const List& list ) {
+      std::vector< typename List::value_type > out;
+      for ( const auto& value : list )
+        out.push_back( value );
+      return out;
+    }
+
+    // the generator of the benchmarks, the tests see the same values every run
+    size_t next_random( size_t& seed ) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      return seed >> 17;
+    }
+
+    // parses and formats 'count' random digits of base 'Base', their negation
+    // and Base^count, whose chunks below the top one are all zero
+    template < size_t Base >
+    bool round_trip( size_t count, size_t& seed ) {
+      constexpr std::string_view symbols = "0123456789ABCDEF";
+
+      // least significant first, this integer is built one digit at a time
+      std::vector< size_t > digits( count );
+      for ( auto& digit : digits )
+        digit = next_random( seed ) % Base;
+      digits.back() = 1 + next_random( seed ) % ( Base - 1 );
+
+      std::string text;
+      for ( auto digit = digits.rbegin(); digit != digits.rend(); ++digit )
+        text.push_back( symbols[*digit] );
+
+      std::vector< size_t > power_digits( count + 1, 0 );
+      power_digits.back()          = 1;
+      const std::string power_text = '1' + std::string( count, '0' );
+
+      const ds::integer< Base > value( digits ), power( power_digits );
+      const auto format = []( const ds::integer< Base >& n ) {
+        return static_cast< std::string >( n );
+      };
+
+      return ds::integer< Base >( text ) == value && format( value ) == text &&
+             ds::integer< Base >( '-' + text ) == -value && format( -value ) == '-' + text &&
+             ds::integer< Base >( power_text ) == power && format( power ) == power_text &&
+             format( power - 1 ) == std::string( count, symbols[Base - 1] );
+    }
+
+    // a double in +-[ 2^-40, 2^40 ), with every bit of the mantissa random
+    double random_double( size_t& seed ) {
+      const auto bits  = next_random( seed ) & ( ( size_t( 1 ) << 52 ) - 1 );
+      const auto m     = bits | ( size_t( 1 ) << 52 );
+      const auto e     = static_cast< int >( next_random( seed ) % 81 ) - 40 - 52;
+      const auto value = std::ldexp( static_cast< double >( m ), e );
+      return next_random( seed ) % 2 ? -value : value;
+    }
+
+    bool same_bits( double a, double b ) {
+      return std::bit_cast< std::uint64_t >( a ) == std::bit_cast< std::uint64_t >( b );
+    }
+  } // namespace
+
+  size_t failed_checks() { return failures; }
+
   void stack() {
     ds::stack< int > st;
 
@@ -93,7 +242,31 @@ namespace test {
     std::cout << list << "\n\n";
 
     // index operator test
-    std::cout << list[5];
+    std::cout << list[5] << '\n';
+
+    // erase by iterator, the next emplace reuses the freed node first
+    ds::list< int > nodes;
+    for ( int i = 0; i < 10; ++i )
+      nodes.emplace_back( i );
+
+    auto iter = nodes.begin();
+    ++iter;
+    ++iter;
+    const int* freed = std::addressof( *iter );
+    nodes.erase( iter );
+
+    const auto reused = nodes.emplace_back( 10 );
+    check( "list erase by iterator",
+           values_of( nodes ) == std::vector< int >{ 0, 1, 3, 4, 5, 6, 7, 8, 9, 10 } );
+    check( "list reuses erased nodes", std::addressof( *reused ) == freed );
+
+    // the pool grows by new chunks, the nodes of the old ones never move
+    const int* front = std::addressof( *nodes.begin() );
+    nodes.resize( 100 );
+    for ( int i = 0; i < 5000; ++i )
+      nodes.emplace_back( i );
+    check( "list nodes stay put while the pool grows",
+           std::addressof( *nodes.begin() ) == front && *reused == 10 && nodes.size() == 5010 );
   }
 
   void vector() {
@@ -164,6 +337,17 @@ namespace test {
     std::cout << '\n';
 
     std::cout << vec;
+
+    // inserting an element of the vector itself which is shifted to open the
+    // gap, once on each side of the middle
+    ds::vector< std::string > words;
+    for ( int i = 0; i < 10; ++i )
+      words.push_back( std::string( 20, static_cast< char >( 'a' + i ) ) );
+
+    words.insert( words[7], 6 );
+    words.insert( words[1], 2 );
+    check( "vector self insert", words[2] == std::string( 20, 'b' ) &&
+                                   words[7] == std::string( 20, 'h' ) && words.size() == 12 );
   }
 
   void output_range() {
@@ -199,22 +383,818 @@ namespace test {
 
     i = 21;
 
-    std::cout << " i <32> = " << i << '\n';
-    std::cout << " j <10> = " << j << '\n';
-    std::cout << " j <32> = " << static_cast< ds::integer< 32 > >( j ) << '\n';
-    std::cout << " k <16> = " << k << '\n';
-    std::cout << " str_test <10> = " << str_test << '\n' << '\n';
-
-    // TODO: converiton from large to lower bases is currently brocken
-    std::cout << " l <64 -> 10> = " << static_cast< ds::Int >( l ) << '\n';
-    std::cout << " j <10 -> 32> = " << static_cast< ds::Int_32 >( j ) << '\n';
-    std::cout << " i + j = " << ds::Int( i + j ) << '\n';
-    std::cout << " i + j = " << ds::Int( i + j ) << '\n';
-    std::cout << " i + j = " << ds::Int( i + j ) << '\n';
-    std::cout << " i * j = " << ds::Int( i * j ) << '\n';
-    std::cout << " i * j = " << ds::Int( i * j ) << '\n';
-    std::cout << " i * j = " << ds::Int( i * j ) << '\n';
-    std::cout << " j - k = " << k - j << '\n';
+    check( "integer format in its base", static_cast< std::string >( i ) == "L" &&
+                                           static_cast< std::string >( j ) == "10000" &&
+                                           static_cast< std::string >( k ) == "2710" );
+    check( "integer parse", str_test == 10912 && ds::Int_hex( "-2A" ) == -42 );
+
+    // the limbs don't depend on the base, a cast only changes the symbols
+    check( "integer base casts",
+           static_cast< std::string >( static_cast< ds::integer< 32 > >( j ) ) == "9OG" &&
+             static_cast< ds::Int >( l ) == 200 && static_cast< ds::Int_32 >( j ) == 10000 );
+
+    // 2^64 is the first number of two limbs
+    const ds::Int two_64( "18446744073709551616" );
+    check( "integer limbs", two_64 - 1 == ds::Int( "18446744073709551615" ) &&
+                              two_64 * two_64 ==
+                                ds::Int( "340282366920938463463374607431768211456" ) );
+
+    check( "integer + and *", ds::Int( i + j ) == 10021 && ds::Int( i * j ) == 210000 );
+    check( "integer j - k", k - j == 0 && j - 10021 == -21 );
+
+    // a moved from integer is zero, not a negative zero
+    ds::Int c = -5;
+    ds::Int d = std::move( c );
+    check( "integer moved from is zero", c == 0 && static_cast< std::string >( c ) == "0" &&
+                                           d == -5 );
+    c = ds::Int( -7 );
+    d = std::move( c );
+    check( "integer move assigned from is zero",
+           c == 0 && static_cast< std::string >( c ) == "0" && d == -7 );
+
+    check( "integer / and %", ds::Int( i * j / k ) == 21 && j % i == 4 );
+    check( "integer / and % truncate", ds::Int( -7 ) / 2 == -3 && ds::Int( -7 ) % 2 == -1 &&
+                                         ds::Int( 7 ) / -2 == -3 && ds::Int( 7 ) % -2 == 1 );
+
+    j += i;
+    j *= 3;
+    check( "integer compound operators", j == 30063 && ( j << 70 >> 66 ) == 481008 &&
+                                           ( ds::Int( 3 ) << 64 ) == two_64 * 3 );
+
+    // like the built in shift, negative numbers round toward negative infinity
+    check( "integer >> of negative numbers", ( ds::Int( -5 ) >> 1 ) == -3 &&
+                                               ( ds::Int( -4 ) >> 1 ) == -2 &&
+                                               ( ds::Int( -1 ) >> 200 ) == -1 &&
+                                               ( -( ds::Int( 1 ) << 100 ) >> 99 ) == -2 );
+
+    const ds::Int m = 1'000'003;
+    check( "integer powmod and mod_inverse",
+           ds::powmod( j, ds::Int( 65537 ), m ) == 550325 && *ds::mod_inverse( j, m ) == 240662 );
+
+    const ds::uint256 w = ds::uint256( j ) << 200;
+    check( "integer to uint256",
+           static_cast< std::string >( w ) ==
+               "48309378424558024653618006382052371319624988602092101007665266688" &&
+             static_cast< std::string >( w << 50 ) ==
+               "85034815533654081014184942115755182329745144988829789216476663255811204579328" &&
+             ds::int128( -j ) / 7 == -4294 );
+
+    using namespace ds::literals;
+    constexpr ds::Int literal = 123456789012345678901234567890_bi;
+    static_assert( literal == ds::Int( "123456789012345678901234567890" ) );
+    static_assert( 0xFFFF'FFFF'FFFF'FFFF'FFFF_bi == ( ds::Int( 1 ) << 80 ) - 1 );
+    static_assert( literal * literal / ds::Int( "98765432109876543210" ) % 1'000'003 == 126951 );
+    check( "_bi literal", literal * 3 == ds::Int( "370370367037037036703703703670" ) );
+  }
+
+  void growth_policies() {
+    // the block table of a data_manager only moves when the policy asks for more
+    const auto geometric = table_sizes< ds::data_manager< int > >( 1000 );
+    check( "geometric growth moves the table O(log n) times",
+           geometric == std::vector< size_t >{ 10, 21, 43, 87, 175, 351, 703, 1407 } );
+
+    const auto steps =
+      table_sizes< ds::data_manager< int, void, ds::growth::fixed_step< 25 > > >( 1000 );
+    bool by_step = steps.size() == 41;
+    for ( size_t i = 1; i < steps.size(); ++i )
+      by_step = by_step && steps[i] == steps[i - 1] + 25;
+    check( "fixed_step growth adds its step", by_step );
+
+    callback_calls = 0;
+    const auto tripled =
+      table_sizes< ds::data_manager< int, void, ds::growth::callback< triple > > >( 1000 );
+    check( "callback growth applies the function",
+           tripled == std::vector< size_t >{ 10, 30, 90, 270, 810, 2430 } &&
+             callback_calls == 5 );
+  }
+
+  void construction() {
+    // blocks are raw storage, only the pushed elements are ever constructed
+    tracked::live = 0;
+    {
+      ds::data_manager< tracked > dm;
+      dm.reserve( 40 );
+      dm.expand_by( 20 );
+      check( "reserve and expand_by construct nothing", tracked::live == 0 );
+
+      ds::stack< tracked > st;
+      for ( int i = 0; i < 5000; ++i )
+        st.push( tracked( i, -i ) );
+      check( "stack constructs the pushed elements only", tracked::live == 5000 );
+
+      for ( int i = 0; i < 1500; ++i )
+        st.pop();
+      check( "stack pop destroys the element", tracked::live == 3500 && st.top().a == 3499 );
+
+      ds::vector< tracked > vec;
+      for ( int i = 0; i < 5000; ++i )
+        vec.push_back( tracked( i, i ) );
+      vec.erase_at( 10 );
+      vec.erase_at( 4000 );
+      check( "vector erase destroys the element",
+             tracked::live == 3500 + 4998 && vec.size() == 4998 && vec[10].a == 11 );
+
+      vec.clear();
+      check( "vector clear destroys every element", tracked::live == 3500 && vec.size() == 0 );
+    }
+    check( "the destructors destroy the remaining elements", tracked::live == 0 );
+  }
+
+  void pool_allocator() {
+    // a pool of its own, so the counts don't depend on other containers
+    using pool_type = ds::block_pool< 0x800 >;
+    using allocator = ds::pool_allocator< int, 0x800, pool_type >;
+    pool_type pool;
+    size_t chunks = 0;
+
+    {
+      ds::alloc_vector< int, allocator > vec{ allocator( pool ) };
+      for ( int i = 0; i < 100'000; ++i )
+        vec.push_back( i );
+
+      bool values = true;
+      for ( int i = 0; i < 100'000; ++i )
+        values = values && vec[static_cast< size_t >( i )] == i;
+      chunks = pool.chunk_count();
+      check( "pool_allocator vector", values && chunks > 1 );
+
+      // clear keeps the blocks, the second round needs no new chunk
+      vec.clear();
+      for ( int i = 0; i < 100'000; ++i )
+        vec.push_back( -i );
+      check( "pool_allocator reuses blocks after clear",
+             pool.chunk_count() == chunks && vec[99'999] == -99'999 );
+    }
+
+    // the destroyed vector gave its blocks back to the pool
+    ds::alloc_stack< int, allocator > st{ allocator( pool ) };
+    for ( int i = 0; i < 100'000; ++i )
+      st.push( i );
+    check( "pool_allocator reuses the blocks of a destroyed container",
+           pool.chunk_count() == chunks && st.top() == 99'999 );
+  }
+
+  void segments() {
+    // pushing to both ends puts head and tail in the middle of blocks, and
+    // small vectors fit into one block
+    constexpr int block = static_cast< int >( ds::vector< int >::segments_type::size );
+    bool split = true, copied = true, filled = true, found = true, summed = true;
+
+    for ( const int front : { 0, 1, block - 1, block, block + 1, 3 * block / 2 } ) {
+      for ( const int back : { 0, 1, block - 1, block, 2 * block + 3 } ) {
+        ds::vector< int > vec;
+        for ( int i = 0; i < front; ++i )
+          vec.push_front( -i );
+        for ( int i = 0; i < back; ++i )
+          vec.push_back( i * 3 );
+
+        std::vector< int > expected;
+        for ( size_t i = 0; i < vec.size(); ++i )
+          expected.push_back( vec[i] );
+
+        // every segment lies inside one block and they cover the vector in order
+        std::vector< int > joined;
+        for ( auto segment : vec.segments() ) {
+          split = split && !segment.empty() && segment.size() <= size_t( block );
+          joined.insert( joined.end(), segment.begin(), segment.end() );
+        }
+        split = split && joined == expected;
+
+        std::vector< int > out( expected.size() + 1, 7 );
+        const auto out_end = ds::copy( vec, out.begin() );
+        copied = copied && out_end == out.begin() + static_cast< std::ptrdiff_t >( vec.size() ) &&
+                 std::equal( expected.begin(), expected.end(), out.begin() ) && out.back() == 7;
+
+        summed = summed && ds::accumulate( vec, 0L ) ==
+                             std::accumulate( expected.begin(), expected.end(), 0L );
+
+        for ( const int value : { 0, -1, 3 * ( back - 1 ), -( front - 1 ), 1 } ) {
+          const auto pos = std::find( expected.begin(), expected.end(), value );
+          const auto at  = static_cast< size_t >( pos - expected.begin() );
+          found = found && ds::find( vec, value ) ==
+                             ( pos == expected.end() ? nullptr : std::addressof( vec[at] ) );
+        }
+
+        ds::fill( vec, 5 );
+        for ( size_t i = 0; i < vec.size(); ++i )
+          filled = filled && vec[i] == 5;
+      }
+    }
+
+    check( "segments cover the elements block by block", split );
+    check( "segmented copy like std::copy", copied );
+    check( "segmented fill", filled );
+    check( "segmented find like std::find", found );
+    check( "segmented accumulate like std::accumulate", summed );
+  }
+
+  void bulk() {
+    // counts which end just before, on and just after a block boundary
+    constexpr size_t block = ds::vector< int >::segments_type::size;
+    bool reserved = true, pushed = true, appended = true, assigned = true, grown = true,
+         shrunk = true;
+
+    for ( const size_t count : { block - 1, block, block + 1 } ) {
+      std::vector< int > values( count );
+      std::iota( values.begin(), values.end(), 1 );
+      const std::vector< int > reversed( values.rbegin(), values.rend() );
+
+      std::vector< int > twice = values;
+      twice.insert( twice.end(), values.begin(), values.end() );
+
+      std::vector< int > padded = reversed;
+      padded.resize( count + block, -1 );
+
+      const auto middle = reversed.begin() + static_cast< std::ptrdiff_t >( count / 2 );
+      const std::vector< int > half( reversed.begin(), middle );
+
+      ds::vector< int > vec;
+      ds::stack< int > st;
+
+      vec.reserve( count );
+      st.reserve( count );
+      reserved = reserved && vec.size() == 0 && st.size() == 0;
+
+      vec.push_n( values.begin(), count );
+      st.push_n( values.begin(), count );
+      pushed = pushed && contents( vec ) == values && contents( st ) == values &&
+               st.top() == static_cast< int >( count );
+
+      vec.append_range( values );
+      st.append_range( values );
+      appended = appended && contents( vec ) == twice && contents( st ) == twice;
+
+      vec.assign( reversed.begin(), reversed.end() );
+      st.assign( reversed.begin(), reversed.end() );
+      assigned = assigned && contents( vec ) == reversed && contents( st ) == reversed;
+
+      vec.resize( count + block, -1 );
+      st.resize( count + block, -1 );
+      grown = grown && contents( vec ) == padded && contents( st ) == padded &&
+              vec.size() == count + block && st.size() == count + block;
+
+      vec.resize( count / 2 );
+      st.resize( count / 2 );
+      shrunk = shrunk && contents( vec ) == half && contents( st ) == half &&
+               st.top() == half.back();
+    }
+
+    check( "vector and stack reserve", reserved );
+    check( "vector and stack push_n", pushed );
+    check( "vector and stack append_range", appended );
+    check( "vector and stack assign", assigned );
+    check( "vector and stack resize to grow", grown );
+    check( "vector and stack resize to shrink", shrunk );
+  }
+
+  void emplace() {
+    // no copy and no move, the arguments go straight to the constructor
+    const auto in_place = []( auto&& emplace_all ) {
+      tracked::copies = tracked::moves = 0;
+      emplace_all();
+      return tracked::copies == 0 && tracked::moves == 0;
+    };
+
+    ds::stack< tracked > st;
+    ds::vector< tracked > vec;
+    ds::list< tracked > list;
+    ds::binarytree< tracked > tree;
+
+    check( "stack emplace in place", in_place( [&] {
+             for ( int i = 0; i < 1000; ++i )
+               st.emplace( i, -i );
+           } ) && st.top().a == 999 && st.top().b == -999 );
+
+    check( "vector emplace_back and emplace_front in place", in_place( [&] {
+             for ( int i = 0; i < 1000; ++i ) {
+               vec.emplace_back( i, -i );
+               vec.emplace_front( -i, i );
+             }
+           } ) && vec[0].a == -999 && vec[1999].b == -999 );
+
+    check( "list emplace in place", in_place( [&] {
+             for ( int i = 0; i < 1000; ++i ) {
+               list.emplace_back( i, -i );
+               list.emplace_front( -i, i );
+               list.emplace( size_t( 1 ), 0, 0 );
+             }
+           } ) && list.size() == 3000 );
+
+    check( "binarytree emplace in place", in_place( [&] {
+             for ( int i = 0; i < 1000; ++i )
+               tree.emplace( i * 7 % 1000, i );
+           } ) && tree.find( tracked( 0, 0 ) ) && tree.find( tracked( 999, 0 ) ) );
+
+    // the element is built once and moved into its gap, never copied
+    tracked::copies = 0;
+    vec.emplace( 1000, 5, 5 );
+    check( "vector emplace in the middle without copies",
+           tracked::copies == 0 && vec[1000].a == 5 && vec.size() == 2001 );
+  }
+
+  void indexed_list() {
+    ds::indexed_list< int > list;
+    std::vector< int > expected;
+    size_t seed = 4321;
+    bool same   = true;
+
+    for ( int i = 0; i < 4000; ++i ) {
+      const auto choice = next_random( seed ) % 4;
+      const auto index  = next_random( seed ) % ( expected.size() + 1 );
+
+      if ( choice < 2 || expected.empty() ) {
+        list.insert( i, index );
+        expected.insert( expected.begin() + static_cast< std::ptrdiff_t >( index ), i );
+      } else if ( choice == 2 ) {
+        const auto at = index % expected.size();
+        list.erase_at( at );
+        expected.erase( expected.begin() + static_cast< std::ptrdiff_t >( at ) );
+      } else {
+        const auto at = index % expected.size();
+        same          = same && list[at] == expected[at];
+      }
+    }
+    check( "indexed_list insert, erase and index",
+           same && list.size() == expected.size() && values_of( list ) == expected );
+
+    // the moved to list keeps the tree and its priorities
+    ds::indexed_list< int > moved;
+    moved.emplace( size_t( 0 ), -1 );
+    moved = std::move( list );
+    for ( int i = 0; i < 200; ++i ) {
+      const auto index = next_random( seed ) % ( expected.size() + 1 );
+      moved.emplace( index, -i );
+      expected.insert( expected.begin() + static_cast< std::ptrdiff_t >( index ), -i );
+    }
+    same = true;
+    for ( size_t i = 0; i < expected.size(); ++i )
+      same = same && moved[i] == expected[i];
+    check( "indexed_list move assignment", same && values_of( moved ) == expected );
+  }
+
+  void binarytree() {
+    // an AVL tree of n elements is less than 1.45 * log2( n + 2 ) high
+    const auto balanced = []( const ds::binarytree< int >& tree ) {
+      return tree.height() <= 1.45 * std::log2( static_cast< double >( tree.size() ) + 2 );
+    };
+
+    ds::binarytree< int > sorted;
+    for ( int i = 0; i < 1000; ++i )
+      sorted.insert( i );
+
+    std::vector< int > expected( 1000 );
+    std::iota( expected.begin(), expected.end(), 0 );
+    check( "binarytree sorted insert",
+           std::ranges::equal( sorted, expected ) && sorted.size() == 1000 && balanced( sorted ) );
+
+    ds::binarytree< int > random;
+    expected.clear();
+    size_t seed = 99;
+    for ( int i = 0; i < 1000; ++i ) {
+      // duplicates are kept
+      const int value = static_cast< int >( next_random( seed ) % 500 );
+      random.insert( value );
+      expected.push_back( value );
+    }
+    std::ranges::sort( expected );
+    check( "binarytree random insert",
+           std::ranges::equal( random, expected ) && random.size() == 1000 && balanced( random ) );
+
+    const std::multiset< int > reference( expected.begin(), expected.end() );
+    bool bounds = random.lower_bound( -1 ) == random.begin() &&
+                  random.upper_bound( -1 ) == random.begin() &&
+                  random.lower_bound( expected.back() + 1 ) == random.end() &&
+                  random.upper_bound( expected.back() ) == random.end() &&
+                  *random.lower_bound( expected.front() ) == expected.front() &&
+                  *--random.end() == expected.back();
+    for ( int key = -1; key < 502; ++key ) {
+      // equal positions in the in-order sequence
+      const auto lower = std::distance( random.begin(), random.lower_bound( key ) );
+      const auto upper = std::distance( random.begin(), random.upper_bound( key ) );
+      bounds = bounds && lower == std::distance( reference.begin(), reference.lower_bound( key ) );
+      bounds = bounds && upper == std::distance( reference.begin(), reference.upper_bound( key ) );
+    }
+    check( "binarytree lower_bound and upper_bound", bounds );
+
+    const auto in_range = random.range( 100, 200 );
+    check( "binarytree range",
+           std::ranges::equal( in_range, std::ranges::subrange( reference.lower_bound( 100 ),
+                                                                reference.lower_bound( 200 ) ) ) );
+
+    check( "binarytree iterate backwards",
+           std::ranges::equal( std::views::reverse( random ), std::views::reverse( expected ) ) );
+
+    // 4 is the root of the balanced tree 1 .. 7, 2 has two children as well
+    ds::binarytree< int > small;
+    for ( int i = 1; i <= 7; ++i )
+      small.insert( i );
+    const bool removed = small.remove( 4 ) && small.remove( 2 ) && !small.remove( 4 );
+    check( "binarytree remove with two children",
+           removed && std::ranges::equal( small, std::vector< int >{ 1, 3, 5, 6, 7 } ) &&
+             balanced( small ) );
+
+    // erase hands out the next iterator, the others stay valid
+    auto kept = random.lower_bound( 301 );
+    for ( auto iter = random.begin(); iter != random.end(); )
+      iter = *iter % 2 == 0 ? random.erase( iter ) : std::next( iter );
+    std::erase_if( expected, []( int value ) { return value % 2 == 0; } );
+    check( "binarytree erase while iterating", std::ranges::equal( random, expected ) &&
+                                                 random.size() == expected.size() &&
+                                                 *kept == 301 && balanced( random ) );
+
+    bool removes = true;
+    std::multiset< int > rest( expected.begin(), expected.end() );
+    for ( int i = 0; i < 1000; ++i ) {
+      const int value = static_cast< int >( next_random( seed ) % 500 );
+      const auto pos  = rest.find( value );
+      removes         = removes && random.remove( value ) == ( pos != rest.end() );
+      if ( pos != rest.end() )
+        rest.erase( pos );
+      removes = removes && balanced( random );
+    }
+    check( "binarytree remove", removes && std::ranges::equal( random, rest ) );
+
+    // a perfectly balanced tree of n elements is bit_width( n ) high
+    bool built = true;
+    for ( const size_t n : { 0, 1, 2, 3, 4, 7, 8, 255, 256, 1023, 1024 } ) {
+      std::vector< int > values( n );
+      std::iota( values.begin(), values.end(), 0 );
+
+      auto tree = ds::binarytree< int >::build_from_sorted( values );
+      built     = built && std::ranges::equal( tree, values ) && tree.size() == n &&
+              tree.height() == static_cast< int >( std::bit_width( n ) );
+
+      // the built tree rebalances like any other
+      for ( int i = 0; i < 20; ++i ) {
+        for ( const int value : { static_cast< int >( n ) + i, -i } ) {
+          tree.insert( value );
+          values.push_back( value );
+        }
+      }
+      std::ranges::sort( values );
+      built = built && std::ranges::equal( tree, values ) && balanced( tree );
+    }
+    check( "binarytree build_from_sorted", built );
+  }
+
+  void btree() {
+    // 16 byte nodes hold 4 elements, so a few hundred keys split and merge
+    // nodes on several levels
+    using map = ds::btree_map< int, int, std::less< int >, 16 >;
+    static_assert( std::bidirectional_iterator< map::iterator > );
+    static_assert( std::bidirectional_iterator< map::const_iterator > );
+    static_assert( std::bidirectional_iterator< ds::btree_set< int >::iterator > );
+
+    const auto same = []( const map& tree, const std::map< int, int >& expected ) {
+      return tree.size() == expected.size() &&
+             std::equal( tree.begin(), tree.end(), expected.begin(), expected.end(),
+                         []( const auto& a, const auto& b ) {
+                           return a.first == b.first && a.second == b.second;
+                         } );
+    };
+
+    map tree;
+    std::map< int, int > expected;
+    size_t seed   = 77;
+    bool inserted = true;
+    for ( int i = 0; i < 2000; ++i ) {
+      const int key   = static_cast< int >( next_random( seed ) % 1000 );
+      const bool news = tree.insert( key, i ).second;
+      inserted        = inserted && news == expected.emplace( key, i ).second;
+    }
+    check( "btree insert", inserted && same( tree, expected ) );
+
+    for ( int key = 0; key < 1000; key += 3 ) {
+      tree[key]     = -key;
+      expected[key] = -key;
+    }
+    tree.begin()->second     = 5;
+    expected.begin()->second = 5;
+    check( "btree overwrite", same( tree, expected ) );
+
+    bool bounds = true;
+    for ( int key = -2; key < 1003; ++key ) {
+      const auto lower = tree.lower_bound( key );
+      const auto upper = tree.upper_bound( key );
+      const auto l     = expected.lower_bound( key );
+      const auto u     = expected.upper_bound( key );
+      bounds = bounds && ( lower == tree.end() ? l == expected.end() : lower.key() == l->first );
+      bounds = bounds && ( upper == tree.end() ? u == expected.end() : upper.key() == u->first );
+      bounds = bounds && tree.contains( key ) == expected.contains( key );
+    }
+    check( "btree lower_bound and upper_bound", bounds );
+
+    long range_sum = 0, expected_sum = 0;
+    for ( const auto& [key, value] : tree.range( 100, 900 ) )
+      range_sum += key + value;
+    for ( auto iter = expected.lower_bound( 100 ); iter != expected.lower_bound( 900 ); ++iter )
+      expected_sum += iter->first + iter->second;
+    check( "btree range", range_sum == expected_sum );
+
+    bool backwards = true;
+    auto iter      = tree.end();
+    for ( auto e = expected.rbegin(); e != expected.rend(); ++e )
+      backwards = backwards && ( --iter )->first == e->first;
+    check( "btree iterate backwards", backwards && iter == tree.begin() );
+
+    const auto built = map::build_from_sorted( expected );
+    check( "btree build_from_sorted", same( built, expected ) );
+
+    // bulk loading fills the nodes, so the tree is as low as possible: 4
+    // elements per leaf and 5 children per inner node
+    bool loaded = true;
+    for ( const size_t n : { 0, 1, 3, 4, 15, 16, 63, 64, 255, 256, 1023, 1024 } ) {
+      std::map< int, int > values;
+      for ( size_t i = 0; i < n; ++i )
+        values.emplace( static_cast< int >( 2 * i ), static_cast< int >( i ) );
+
+      auto loaded_tree = map::build_from_sorted( values );
+      size_t height = 0;
+      for ( size_t nodes = ( n + 3 ) / 4; nodes > 1; nodes = ( nodes + 4 ) / 5 )
+        ++height;
+      loaded = loaded && same( loaded_tree, values ) && loaded_tree.height() == height;
+
+      // inserts into the full nodes split them, erases merge them again
+      for ( int i = 0; i < 2 * static_cast< int >( n ) + 40; i += 3 ) {
+        loaded_tree.insert( i, -i );
+        values.emplace( i, -i );
+      }
+      loaded = loaded && same( loaded_tree, values );
+      for ( int i = 0; i < 2 * static_cast< int >( n ) + 40; i += 2 ) {
+        loaded_tree.erase( i );
+        values.erase( i );
+      }
+      loaded = loaded && same( loaded_tree, values );
+    }
+    check( "btree build_from_sorted sizes", loaded );
+
+    map copy = tree;
+    copy.erase( copy.begin().key() );
+    copy[-1] = 1;
+    check( "btree copy", same( tree, expected ) && copy.size() == tree.size() &&
+                           copy.begin().key() == -1 );
+
+    bool erased = true;
+    for ( int i = 0; i < 3000; ++i ) {
+      const int key = static_cast< int >( next_random( seed ) % 1000 );
+      erased        = erased && tree.erase( key ) == expected.erase( key );
+      if ( i % 100 == 0 )
+        erased = erased && same( tree, expected );
+    }
+    for ( int key = 0; key < 1000; ++key )
+      erased = erased && tree.erase( key ) == expected.erase( key );
+    check( "btree erase to empty", erased && tree.is_empty() && tree.begin() == tree.end() &&
+                                     tree.lower_bound( 5 ) == tree.end() );
+
+    tree.insert( 3, 4 );
+    check( "btree reuse after erase", tree.size() == 1 && tree.begin()->second == 4 );
+  }
+
+  void multiplication() {
+    using ds::limbs::limb;
+    size_t seed = 17;
+
+    const auto random_limbs = [&]( size_t n ) {
+      std::vector< limb > out( n );
+      for ( auto& value : out )
+        value = next_random( seed ) << 32 ^ next_random( seed );
+      return out;
+    };
+
+    const auto like_basecase = []( const std::vector< limb >& a, const std::vector< limb >& b ) {
+      std::vector< limb > product( a.size() + b.size() ), expected( a.size() + b.size() );
+      ds::limbs::mul( product.data(), a.data(), a.size(), b.data(), b.size() );
+      ds::limbs::mul_basecase( expected.data(), a.data(), a.size(), b.data(), b.size() );
+      return product == expected;
+    };
+
+    // sizes around the thresholds, where mul changes the algorithm
+    constexpr size_t k = ds::limbs::karatsuba_threshold;
+    constexpr size_t t = ds::limbs::toom3_threshold;
+    const std::vector< size_t > sizes = { k - 1, k, k + 1, t - 1, t, t + 1 };
+
+    bool balanced = true, unbalanced = true, ones = true;
+    for ( const size_t an : sizes ) {
+      const std::vector< limb > all_ones( an, ~limb( 0 ) );
+      balanced = balanced && like_basecase( random_limbs( an ), random_limbs( an ) );
+      ones     = ones && like_basecase( all_ones, all_ones );
+
+      for ( const size_t bn : sizes ) {
+        const std::vector< limb > b_ones( bn, ~limb( 0 ) );
+        unbalanced = unbalanced && like_basecase( random_limbs( 3 * an + 1 ), random_limbs( bn ) );
+        ones       = ones && like_basecase( std::vector< limb >( 2 * an + 3, ~limb( 0 ) ), b_ones );
+      }
+    }
+
+    check( "limbs::mul like mul_basecase, balanced", balanced );
+    check( "limbs::mul like mul_basecase, unbalanced", unbalanced );
+    check( "limbs::mul like mul_basecase, all ones", ones );
+  }
+
+  void division() {
+    using ds::limbs::limb;
+    size_t seed = 23;
+
+    const auto random_limbs = [&]( size_t n ) {
+      std::vector< limb > out( n );
+      for ( auto& value : out )
+        value = next_random( seed ) << 32 ^ next_random( seed );
+      out.back() |= 1;
+      return out;
+    };
+
+    // the limbs are the digits of base 2^64
+    const ds::Int limb_base( "18446744073709551616" );
+    const auto from_limbs = [&]( const std::vector< limb >& digits ) {
+      ds::Int out;
+      for ( auto digit = digits.rbegin(); digit != digits.rend(); ++digit )
+        out = out * limb_base + ds::Int( *digit );
+      return out;
+    };
+
+    // the quotient and remainder of n and -n by d
+    const auto divides = [&]( const std::vector< limb >& n_limbs,
+                              const std::vector< limb >& d_limbs ) {
+      const auto d = from_limbs( d_limbs );
+      bool ok      = true;
+      for ( const auto& n : { from_limbs( n_limbs ), -from_limbs( n_limbs ) } ) {
+        const auto [q, r] = divmod( n, d );
+        ok = ok && q * d + r == n && ( r < 0 ? -r : r ) < d &&
+             ( r == 0 || ( r < 0 ) == ( n < 0 ) );
+      }
+      return ok;
+    };
+
+    // below, at and above the size where the reciprocal takes over
+    constexpr size_t newton = ds::limbs::div_newton_threshold;
+    const std::pair< size_t, size_t > sizes[] = {
+      { 3, 2 },
+      { 90, 41 },
+      { 2 * newton + 10, newton - 1 },
+      { 2 * newton, newton },
+      { 2 * newton + 200, newton + 50 },
+    };
+
+    bool random = true, ones = true, small_top = true;
+    for ( const auto& [an, bn] : sizes ) {
+      const auto n = random_limbs( an );
+      random       = random && divides( n, random_limbs( bn ) );
+      ones         = ones && divides( n, std::vector< limb >( bn, ~limb( 0 ) ) );
+
+      // the divisor is shifted by 63 bits to normalize it
+      auto d   = random_limbs( bn );
+      d.back() = 1;
+      small_top = small_top && divides( n, d );
+    }
+
+    check( "divmod with random divisors", random );
+    check( "divmod with all ones divisors", ones );
+    check( "divmod with a small top limb", small_top );
+  }
+
+  void radix_conversion() {
+    // sizes around the radix threshold and thousands of digits, where the
+    // conversion divides and conquers
+    size_t seed = 31;
+    bool decimal = true, hex = true, septenary = true;
+
+    for ( const size_t count : { 500, 800, 3000, 7001 } ) {
+      decimal   = decimal && round_trip< 10 >( count, seed );
+      hex       = hex && round_trip< 16 >( count, seed );
+      septenary = septenary && round_trip< 7 >( count, seed );
+    }
+
+    check( "integer< 10 > parse and format thousands of digits", decimal );
+    check( "integer< 16 > parse and format thousands of digits", hex );
+    check( "integer< 7 > parse and format thousands of digits", septenary );
+  }
+
+  void modular() {
+    using ds::limbs::limb;
+
+    // 2^128 - 159 is prime and takes two limbs, the even modulus takes the
+    // fallback without Montgomery multiplication
+    const ds::Int base( "123456789012345678901234567890" );
+    const ds::Int exponent = ( ds::Int( 1 ) << 100 ) + 12345;
+    const ds::Int odd( "340282366920938463463374607431768211297" );
+    const ds::Int even( "1000000000000000000000000000006" );
+
+    const ds::Int odd_result( "318679105398225099122586266393729021737" );
+    const ds::Int even_result( "809917806137685663537195991096" );
+
+    check( "powmod with a 128 bit odd modulus", ds::powmod( base, exponent, odd ) == odd_result );
+    check( "powmod with an even modulus", ds::powmod( base, exponent, even ) == even_result );
+    check( "mod_inverse of a number sharing a factor",
+           ds::mod_inverse( ds::Int( 6 ), ds::Int( 9 ) ) == std::nullopt &&
+             ds::mod_inverse( ds::Int( 7 ), ds::Int( 9 ) ) == 4 );
+
+    const ds::fixed_montgomery< 2 > fixed( odd );
+    const ds::montgomery<> dynamic( odd );
+    size_t seed = 99;
+    bool same   = fixed.pow( base, exponent ) == dynamic.pow( base, exponent );
+    for ( int i = 0; i < 50; ++i ) {
+      const std::array< limb, 3 > x = { next_random( seed ), next_random( seed ),
+                                        next_random( seed ) };
+      const auto b = ds::Int::from_limbs( x );
+      const auto e = ds::Int( next_random( seed ) ) << 40;
+      same         = same && fixed.pow( b, e ) == dynamic.pow( b, e );
+    }
+    check( "fixed_montgomery pow like montgomery pow", same );
+  }
+
+  void wide_integer() {
+    static_assert( std::is_trivially_copyable_v< ds::uint256 > );
+
+    check( "uint256 wraps around",
+           ~ds::uint256() * ~ds::uint256() == 1 && ~ds::uint256() + 1 == 0 );
+    check( "int256 / and % truncate", ds::int256( -7 ) / 2 == -3 && ds::int256( -7 ) % 2 == -1 );
+    check( "int256 >> rounds down",
+           ( ds::int256( -5 ) >> 1 ) == -3 && ( ds::int256( -1 ) >> 200 ) == -1 );
+
+    // every int256 survives the trip through ds::Int, wider values keep their
+    // low bits
+    size_t seed     = 5;
+    bool round_trip = true;
+    for ( int i = 0; i < 200; ++i ) {
+      std::array< ds::limbs::limb, 4 > x;
+      for ( auto& value : x )
+        value = next_random( seed ) << 32 ^ next_random( seed );
+
+      const auto shift = 1 + next_random( seed ) % 255;
+      const auto value = ds::Int::from_limbs( x, i % 2 == 1 ) >> shift;
+      round_trip       = round_trip && static_cast< ds::Int >( ds::int256( value ) ) == value;
+    }
+    check( "int256 round trip through ds::Int", round_trip );
+    check( "uint256 from a wider ds::Int",
+           ds::uint256( ( ds::Int( 1 ) << 256 ) + 5 ) == 5 && ds::uint256( ds::Int( -1 ) ) ==
+                                                                ~ds::uint256() );
+  }
+
+  void floatingpoint() {
+    const ds::Float third = ds::Float( 1 ) / 3;
+    const ds::floatingpoint< 10, 40 > two( 2 );
+
+    std::cout << " 1 / 3 = " << third << '\n';
+    std::cout << " 0.1 + 0.2 = " << ds::Float( "0.1" ) + ds::Float( "0.2" ) << '\n';
+    std::cout << " sqrt( 2 ) <40 digits> = " << sqrt( two ) << '\n';
+    std::cout << " 1e20 + 1 - 1e20 <40 digits> = "
+              << ds::floatingpoint< 10, 40 >( "1e20" ) + 1 - ds::floatingpoint< 10, 40 >( "1e20" )
+              << '\n';
+
+    // 53 bits and round to nearest even, like a double
+    using Double = ds::floatingpoint< 2, 52 >;
+    size_t seed  = 2024;
+    bool add = true, sub = true, mul = true, div = true, root = true;
+    for ( int i = 0; i < 4000; ++i ) {
+      const double a = random_double( seed );
+      // every fourth b is close to a, for cancellations in the subtraction
+      const double b = i % 4 == 0 ? a * ( 1 + std::ldexp( random_double( seed ), -45 ) )
+                                  : random_double( seed );
+
+      const Double x( a ), y( b );
+      add  = add && same_bits( static_cast< double >( x + y ), a + b );
+      sub  = sub && same_bits( static_cast< double >( x - y ), a - b );
+      mul  = mul && same_bits( static_cast< double >( x * y ), a * b );
+      div  = div && same_bits( static_cast< double >( x / y ), a / b );
+      root = root && same_bits( static_cast< double >( sqrt( x < 0 ? -x : x ) ),
+                                std::sqrt( std::abs( a ) ) );
+    }
+    check( "floatingpoint< 2, 52 > + like double", add );
+    check( "floatingpoint< 2, 52 > - like double", sub );
+    check( "floatingpoint< 2, 52 > * like double", mul );
+    check( "floatingpoint< 2, 52 > / like double", div );
+    check( "floatingpoint< 2, 52 > sqrt like double", root );
+
+    // decimal strings end at the nearest double after both roundings, like strtod
+    using Wide  = ds::floatingpoint< 10, 40 >;
+    bool parsed = true;
+    for ( int i = 0; i < 2000; ++i ) {
+      std::string text = std::to_string( next_random( seed ) % 100'000'000'000'000'000ULL );
+      text += 'e' + std::to_string( static_cast< int >( next_random( seed ) % 601 ) - 300 );
+      parsed = parsed && same_bits( static_cast< double >( Wide( text ) ),
+                                    std::strtod( text.c_str(), nullptr ) );
+    }
+    check( "floatingpoint< 10, 40 > parse like strtod", parsed );
+
+    // 15 significant digits survive the 54 bits of a Float
+    bool round_trip = true;
+    for ( int i = 0; i < 2000; ++i ) {
+      std::string text = std::to_string( next_random( seed ) % 1'000'000'000'000'000ULL );
+      text += 'e' + std::to_string( static_cast< int >( next_random( seed ) % 81 ) - 40 );
+      const ds::Float x( text );
+      round_trip = round_trip && ds::Float( static_cast< std::string >( x ) ) == x;
+    }
+    check( "Float format and parse round trip", round_trip );
+
+    check( "Float format", static_cast< std::string >( ds::Float( "-12.5e-3" ) ) == "-0.0125" &&
+                             static_cast< std::string >( ds::Float( "1.5e16" ) ) == "1.5e16" &&
+                             static_cast< std::string >( ds::Float( "0.000001" ) ) == "1e-6" &&
+                             static_cast< std::string >( ds::Float( 4096 ) ) == "4096" &&
+                             static_cast< std::wstring >( ds::Float( L"0.25" ) ) == L"0.25" );
+
+    // the arithmetic is usable in constant expressions
+    static_assert( ds::Float( 1 ) / 4 + ds::Float( "0.75" ) == 1 );
+    static_assert( sqrt( Wide( 2 ) ) * sqrt( Wide( 2 ) ) - 2 < Wide( "1e-38" ) );
   }
 
 } // namespace test
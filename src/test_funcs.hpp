@@ -1,7 +1,12 @@
 #pragma once
 
+#include <cstddef>
+
 namespace test {
 
+  // number of failed checks of all tests run so far
+  size_t failed_checks();
+
   void stack();
 
   void list();
@@ -14,4 +19,34 @@ namespace test {
 
   void integer();
 
+  void floatingpoint();
+
+  void growth_policies();
+
+  void construction();
+
+  void pool_allocator();
+
+  void segments();
+
+  void bulk();
+
+  void emplace();
+
+  void indexed_list();
+
+  void binarytree();
+
+  void btree();
+
+  void multiplication();
+
+  void division();
+
+  void radix_conversion();
+
+  void modular();
+
+  void wide_integer();
+
 } // namespace test